@@ -0,0 +1,331 @@
+#include <big_int.h>
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/** Measures crossover points between multiplication, division and gcd algorithms of big_int on this machine,
+ *  writes tuning table for big_int::load_tuning and JSON report with all measured samples.
+ *  Every crossover compares one level of the faster algorithm (its threshold set to the operand size)
+ *  against the slower one and takes the first size from which the faster wins twice in a row.
+ *  Usage: mp_os_arthmtc_bg_intgr_bnchmrks_attn [--quick] [table_path [report_path]],
+ *  defaults are big_int_tuning.txt and big_int_tuning.json
+ */
+
+namespace
+{
+    using json = nlohmann::json;
+
+    constexpr size_t never = std::numeric_limits<size_t>::max() / 4;
+
+    bool quick = false;
+
+    big_int random_big_int(size_t limbs, std::mt19937_64 &generator)
+    {
+        std::vector<unsigned int> digits(2 * limbs);
+
+        for (auto &digit: digits)
+            digit = static_cast<unsigned int>(generator());
+
+        digits.back() |= 1u << 31;
+        return big_int(digits);
+    }
+
+    /** Minimum over several runs of mean time of one call in microseconds
+     */
+    double measure(const std::function<void()> &operation)
+    {
+        const size_t runs = quick ? 3 : 7;
+        const auto run_time = std::chrono::milliseconds(quick ? 2 : 10);
+        double best = std::numeric_limits<double>::infinity();
+
+        for (size_t run = 0; run < runs; ++run)
+        {
+            size_t repeats = 0;
+            auto begin = std::chrono::steady_clock::now(), end = begin;
+
+            do
+            {
+                operation();
+                ++repeats;
+                end = std::chrono::steady_clock::now();
+            } while (end - begin < run_time);
+
+            best = std::min(best, std::chrono::duration<double, std::micro>(end - begin).count() / static_cast<double>(repeats));
+        }
+
+        return best;
+    }
+
+    std::vector<size_t> geometric_sizes(size_t from, size_t to)
+    {
+        std::vector<size_t> sizes;
+
+        for (size_t n = from; n <= to; n = std::max(n + 1, n * 9 / 8))
+            sizes.push_back(n);
+
+        return sizes;
+    }
+
+    /** Sizes are walked upwards, slow and fast take operand size and return time of one operation
+     */
+    std::optional<size_t> crossover(
+        const char *name,
+        const std::vector<size_t> &sizes,
+        const std::function<double(size_t)> &slow,
+        const std::function<double(size_t)> &fast,
+        json &samples)
+    {
+        std::optional<size_t> candidate;
+
+        std::cout << name << ':' << std::endl;
+
+        for (size_t n: sizes)
+        {
+            double slow_time = slow(n), fast_time = fast(n);
+
+            samples.push_back({{"limbs", n}, {"slow_us", slow_time}, {"fast_us", fast_time}});
+            std::cout << "  " << std::setw(6) << n << " limbs: " << std::setw(12) << slow_time << " us vs " << std::setw(12) << fast_time << " us" << std::endl;
+
+            if (fast_time >= slow_time)
+                candidate.reset();
+            else if (!candidate)
+                candidate = n;
+            else
+                return candidate;
+        }
+
+        return std::nullopt;
+    }
+
+    double time_multiplication(const big_int &a, const big_int &b, big_int::multiplication_rule rule, size_t threads = 1)
+    {
+        big_int res;
+
+        return measure([&]
+        {
+            res = a;
+            res.multiply_assign(&a == &b ? res : b, rule, threads);
+        });
+    }
+
+    double time_division(const big_int &a, const big_int &b, big_int::division_rule rule)
+    {
+        big_int res;
+
+        return measure([&]
+        {
+            res = a;
+            res.divide_assign(b, rule);
+        });
+    }
+
+    /** Runs operation with threshold temporarily set to value
+     */
+    double with_threshold(size_t &threshold, size_t value, const std::function<double()> &operation)
+    {
+        size_t saved = threshold;
+        threshold = value;
+        double res = operation();
+        threshold = saved;
+        return res;
+    }
+
+    json tuning_to_json()
+    {
+        std::stringstream table;
+        json res = json::object();
+        std::string name;
+        size_t value;
+
+        big_int::save_tuning(table);
+
+        while (table >> name >> value)
+            res[name] = value;
+
+        return res;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int arg = 1;
+
+    if (arg < argc && std::strcmp(argv[arg], "--quick") == 0)
+    {
+        quick = true;
+        ++arg;
+    }
+
+    std::string table_path = arg < argc ? argv[arg++] : "big_int_tuning.txt";
+    std::string report_path = arg < argc ? argv[arg++] : "big_int_tuning.json";
+
+    using mr = big_int::multiplication_rule;
+    using dr = big_int::division_rule;
+
+    std::mt19937_64 generator(42);
+    std::map<size_t, std::pair<big_int, big_int>> operands;
+
+    auto operands_of = [&](size_t n) -> const std::pair<big_int, big_int> &
+    {
+        auto it = operands.find(n);
+
+        if (it == operands.end())
+            it = operands.emplace(n, std::pair{random_big_int(n, generator), random_big_int(n, generator)}).first;
+
+        return it->second;
+    };
+
+    const size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    json report;
+    report["machine"] = {
+        {"hardware_concurrency", hardware_threads},
+        {"compiler", __VERSION__},
+        {"limb_bits", 64},
+        {"quick", quick},
+        {"time", std::time(nullptr)}};
+    report["defaults"] = tuning_to_json();
+
+    json &crossovers = report["crossovers"];
+
+    auto tune = [&](const char *name, size_t &threshold, const std::vector<size_t> &sizes,
+                    const std::function<double(size_t)> &slow, const std::function<double(size_t)> &fast)
+    {
+        json samples = json::array();
+        auto found = crossover(name, sizes, slow, fast, samples);
+
+        if (found)
+            threshold = *found;
+
+        std::cout << "  " << name << " = " << threshold << (found ? "" : " (no crossover, kept)") << std::endl;
+        crossovers[name] = {{"found", found.has_value()}, {"value", threshold}, {"samples", std::move(samples)}};
+    };
+
+    // one level of each algorithm above the previous one, so thresholds are tuned bottom-up
+
+    tune("karatsuba_threshold", big_int::karatsuba_threshold, geometric_sizes(8, quick ? 96 : 160),
+         [&](size_t n) { auto &[a, b] = operands_of(n); return time_multiplication(a, b, mr::trivial); },
+         [&](size_t n) { auto &[a, b] = operands_of(n);
+             return with_threshold(big_int::karatsuba_threshold, n, [&] { return time_multiplication(a, b, mr::Karatsuba); }); });
+
+    tune("karatsuba_square_threshold", big_int::karatsuba_square_threshold, geometric_sizes(8, quick ? 128 : 256),
+         [&](size_t n) { auto &a = operands_of(n).first; return time_multiplication(a, a, mr::trivial); },
+         [&](size_t n) { auto &a = operands_of(n).first;
+             return with_threshold(big_int::karatsuba_square_threshold, n, [&] { return time_multiplication(a, a, mr::Karatsuba); }); });
+
+    tune("toom3_threshold", big_int::toom3_threshold, geometric_sizes(std::max<size_t>(big_int::karatsuba_threshold, 24), quick ? 768 : 1536),
+         [&](size_t n) { auto &[a, b] = operands_of(n); return time_multiplication(a, b, mr::Karatsuba); },
+         [&](size_t n) { auto &[a, b] = operands_of(n);
+             return with_threshold(big_int::toom3_threshold, n, [&] { return time_multiplication(a, b, mr::Toom3); }); });
+
+    tune("toom4_threshold", big_int::toom4_threshold, geometric_sizes(std::max<size_t>(big_int::toom3_threshold, 32), quick ? 1536 : 3072),
+         [&](size_t n) { auto &[a, b] = operands_of(n); return time_multiplication(a, b, mr::Toom3); },
+         [&](size_t n) { auto &[a, b] = operands_of(n);
+             return with_threshold(big_int::toom4_threshold, n, [&] { return time_multiplication(a, b, mr::Toom4); }); });
+
+    tune("ntt_threshold", big_int::ntt_threshold, geometric_sizes(std::max<size_t>(big_int::toom4_threshold, 256), quick ? 4096 : 16384),
+         [&](size_t n) { auto &[a, b] = operands_of(n); return time_multiplication(a, b, mr::Toom4); },
+         [&](size_t n) { auto &[a, b] = operands_of(n); return time_multiplication(a, b, mr::SchonhageStrassen); });
+
+    tune("burnikel_ziegler_threshold", big_int::burnikel_ziegler_threshold, geometric_sizes(16, quick ? 384 : 768),
+         [&](size_t n) { auto &a = operands_of(2 * n).first; auto &b = operands_of(n).second; return time_division(a, b, dr::trivial); },
+         [&](size_t n) { auto &a = operands_of(2 * n).first; auto &b = operands_of(n).second;
+             return with_threshold(big_int::burnikel_ziegler_threshold, n, [&] { return time_division(a, b, dr::BurnikelZiegler); }); });
+
+    auto time_divisor = [&](size_t n, size_t threshold)
+    {
+        auto &a = operands_of(2 * n).first;
+        auto &b = operands_of(n).second;
+        size_t saved = big_int::newton_threshold;
+        big_int::newton_threshold = threshold;
+        big_int::divisor prepared(b);
+        big_int::newton_threshold = saved;
+        big_int res;
+
+        return measure([&] { res = prepared.mod(a); });
+    };
+
+    tune("newton_threshold", big_int::newton_threshold, geometric_sizes(32, quick ? 768 : 1536),
+         [&](size_t n) { return time_divisor(n, never); },
+         [&](size_t n) { return time_divisor(n, n); });
+
+    auto time_gcd = [&](size_t n)
+    {
+        auto &[a, b] = operands_of(n);
+        return measure([&] { big_int::gcd(a, b); });
+    };
+
+    tune("hgcd_threshold", big_int::hgcd_threshold, geometric_sizes(24, quick ? 384 : 768),
+         [&](size_t n) { return with_threshold(big_int::hgcd_threshold, never, [&] { return time_gcd(n); }); },
+         [&](size_t n) { return with_threshold(big_int::hgcd_threshold, n, [&] { return time_gcd(n); }); });
+
+    if (hardware_threads > 1)
+        tune("parallel_threshold", big_int::parallel_threshold, geometric_sizes(256, quick ? 8192 : 32768),
+             [&](size_t n) { auto &[a, b] = operands_of(n); return time_multiplication(a, b, mr::Karatsuba, 1); },
+             [&](size_t n) { auto &[a, b] = operands_of(n);
+                 return with_threshold(big_int::parallel_threshold, n, [&] { return time_multiplication(a, b, mr::Karatsuba, hardware_threads); }); });
+    else
+        std::cout << "parallel_threshold: single hardware thread, kept " << big_int::parallel_threshold << std::endl;
+
+    // sweep of every rule with tuned thresholds, for the report only
+
+    json &sweep = report["sweep"];
+
+    for (size_t n: geometric_sizes(16, quick ? 2048 : 8192))
+    {
+        auto &[a, b] = operands_of(n);
+        const big_int &third = operands_of(std::max<size_t>(n / 3, 2)).first;
+
+        for (auto [rule, name]: {std::pair{mr::trivial, "trivial"}, std::pair{mr::Karatsuba, "Karatsuba"},
+                                 std::pair{mr::Toom3, "Toom3"}, std::pair{mr::Toom4, "Toom4"},
+                                 std::pair{mr::SchonhageStrassen, "SchonhageStrassen"}})
+        {
+            if (rule == mr::trivial && n > (quick ? 512 : 2048))
+                continue;
+
+            sweep["multiplication"][name].push_back({
+                {"limbs", n},
+                {"balanced_us", time_multiplication(a, b, rule)},
+                {"unbalanced_us", time_multiplication(a, third, rule)},
+                {"square_us", time_multiplication(a, a, rule)}});
+        }
+
+        if (n > (quick ? 1024 : 4096))
+            continue;
+
+        auto &dividend = operands_of(2 * n).first;
+
+        for (auto [rule, name]: {std::pair{dr::trivial, "trivial"}, std::pair{dr::Newton, "Newton"},
+                                 std::pair{dr::BurnikelZiegler, "BurnikelZiegler"}})
+            sweep["division"][name].push_back({{"limbs", n}, {"us", time_division(dividend, b, rule)}});
+    }
+
+    report["thresholds"] = tuning_to_json();
+
+    std::ofstream table(table_path);
+    table << "# big_int tuning table, load with big_int::load_tuning" << std::endl;
+    big_int::save_tuning(table);
+
+    std::ofstream(report_path) << report.dump(2) << std::endl;
+
+    std::cout << "tuning table written to " << table_path << ", report to " << report_path << std::endl;
+
+    if (!table)
+    {
+        std::cerr << "cannot write " << table_path << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
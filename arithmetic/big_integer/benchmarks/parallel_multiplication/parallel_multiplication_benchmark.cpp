@@ -0,0 +1,79 @@
+#include <big_int.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <string>
+
+/** Prints time of one multiplication for 1..64 threads.
+ *  Usage: mp_os_arthmtc_bg_intgr_bnchmrks_prlll_mltplctn [limbs...], default sizes are 4096, 32768 and 262144 limbs
+ */
+
+namespace
+{
+    big_int random_big_int(size_t limbs, std::mt19937_64 &generator)
+    {
+        std::vector<unsigned int> digits(2 * limbs);
+
+        for (auto &digit: digits)
+            digit = static_cast<unsigned int>(generator());
+
+        digits.back() |= 1u << 31;
+        return big_int(digits);
+    }
+
+    double measure(const big_int &a, const big_int &b, big_int::multiplication_rule rule, size_t threads)
+    {
+        size_t repeats = 0;
+        auto begin = std::chrono::steady_clock::now(), end = begin;
+
+        do
+        {
+            big_int res(a);
+            res.multiply_assign(b, rule, threads);
+            ++repeats;
+            end = std::chrono::steady_clock::now();
+        } while (end - begin < std::chrono::milliseconds(500));
+
+        return std::chrono::duration<double, std::milli>(end - begin).count() / static_cast<double>(repeats);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<size_t> sizes;
+
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(std::stoul(argv[i]));
+
+    if (sizes.empty())
+        sizes = {4096, 32768, 262144};
+
+    const size_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+
+    big_int::set_thread_pool_size(64);
+    std::mt19937_64 generator(42);
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (size_t limbs: sizes)
+    {
+        big_int a = random_big_int(limbs, generator), b = random_big_int(limbs, generator);
+
+        for (auto [rule, name]: {std::pair{big_int::multiplication_rule::Karatsuba, "Karatsuba"},
+                                 std::pair{big_int::multiplication_rule::SchonhageStrassen, "SchonhageStrassen"}})
+        {
+            double sequential = measure(a, b, rule, 1);
+
+            std::cout << name << ", " << limbs << " limbs:" << std::endl;
+
+            for (size_t threads: thread_counts)
+            {
+                double time = threads == 1 ? sequential : measure(a, b, rule, threads);
+                std::cout << "  " << std::setw(2) << threads << " threads: " << std::setw(10) << time << " ms, speedup " << sequential / time << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
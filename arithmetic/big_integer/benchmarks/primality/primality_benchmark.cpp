@@ -0,0 +1,79 @@
+#include <big_int.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <string>
+
+/** Prints rate of random prime generation and time of one test of a prime for Miller-Rabin with 25 rounds and BPSW.
+ *  Usage: mp_os_arthmtc_bg_intgr_bnchmrks_prmlty [bits...], default sizes are 1024, 2048, 3072 and 4096 bits
+ */
+
+namespace
+{
+    /** Random odd candidate of exactly given length
+     */
+    big_int random_candidate(size_t bits, std::mt19937_64 &generator)
+    {
+        return big_int::random_bits(bits, generator) | (big_int(1) << (bits - 1)) | big_int(1);
+    }
+
+    double seconds_since(std::chrono::steady_clock::time_point begin)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<size_t> sizes;
+
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(std::stoul(argv[i]));
+
+    if (sizes.empty())
+        sizes = {1024, 2048, 3072, 4096};
+
+    constexpr size_t primes_per_size = 4;
+    std::mt19937_64 generator(42);
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    for (size_t bits: sizes)
+    {
+        for (auto [test, rounds, name]: {std::tuple{big_int::primality_test::MillerRabin, size_t(25), "Miller-Rabin x25"},
+                                         std::tuple{big_int::primality_test::BPSW, size_t(1), "BPSW"}})
+        {
+            std::vector<big_int> primes;
+            size_t candidates = 0;
+            auto begin = std::chrono::steady_clock::now();
+
+            while (primes.size() < primes_per_size)
+            {
+                big_int candidate = random_candidate(bits, generator);
+                ++candidates;
+
+                if (candidate.is_probable_prime(rounds, test))
+                    primes.push_back(std::move(candidate));
+            }
+
+            double search = seconds_since(begin);
+
+            begin = std::chrono::steady_clock::now();
+
+            for (const auto &prime: primes)
+            {
+                if (!prime.is_probable_prime(rounds, test))
+                    return EXIT_FAILURE;
+            }
+
+            double confirm = seconds_since(begin) / primes_per_size;
+
+            std::cout << name << ", " << bits << " bits: " << std::setw(9) << primes_per_size / search << " primes/s, "
+                      << std::setw(10) << candidates / search << " candidates/s, " << std::setw(9) << confirm * 1000
+                      << " ms per prime" << std::endl;
+        }
+    }
+
+    return 0;
+}
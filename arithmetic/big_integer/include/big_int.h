@@ -6,21 +6,49 @@
 #define MP_OS_BIG_INT_H
 
 #include <vector>
+#include <functional>
 #include <utility>
 #include <iostream>
 #include <concepts>
+#include <type_traits>
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <bit>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
 #include <pp_allocator.h>
 #include <not_implemented.h>
 
+/** Limb kernels backend selection.
+ *  Define MP_OS_BIG_INT_PORTABLE to force the half-word fallback (useful for testing it on x86-64).
+ */
+#if !defined(MP_OS_BIG_INT_PORTABLE)
+#   if defined(__SIZEOF_INT128__)
+#       define MP_OS_BIG_INT_HAS_INT128 1
+#   endif
+#   if defined(__x86_64__) || defined(_M_X64)
+#       define MP_OS_BIG_INT_X86_64 1
+#       if defined(_MSC_VER) && !defined(__clang__)
+#           include <intrin.h>
+#       else
+#           include <immintrin.h>
+#       endif
+#   endif
+#endif
+
 namespace __detail
 {
-    constexpr unsigned int generate_half_mask()
+    template<std::unsigned_integral T = unsigned int>
+    constexpr T generate_half_mask()
     {
-        unsigned int res = 0;
+        T res = 0;
 
-        for(size_t i = 0; i < sizeof(unsigned int) * 4; ++i)
+        for(size_t i = 0; i < sizeof(T) * 4; ++i)
         {
-            res |= (1u << i);
+            res |= (T(1) << i);
         }
 
         return res;
@@ -42,15 +70,401 @@ namespace __detail
             }
         }
 
-        return ones_counter <= 1 ? (1u << index) : (1u << (index + 1));
+        return ones_counter <= 1 ? (o << index) : (o << (index + 1));
+    }
+
+    using limb_type = unsigned long long;
+
+    constexpr size_t limb_bits = sizeof(limb_type) * 8;
+
+    /** a + b + carry, carry is 0 or 1 on input and output
+     */
+    constexpr limb_type add_with_carry(limb_type a, limb_type b, limb_type &carry) noexcept
+    {
+#if defined(MP_OS_BIG_INT_X86_64)
+        if (!std::is_constant_evaluated())
+        {
+            unsigned long long res;
+            carry = _addcarry_u64(static_cast<unsigned char>(carry), a, b, &res);
+            return res;
+        }
+#endif
+        limb_type res = a + b;
+        limb_type c = res < a;
+        res += carry;
+        carry = c | (res < carry);
+        return res;
+    }
+
+    /** a - b - borrow, borrow is 0 or 1 on input and output
+     */
+    constexpr limb_type sub_with_borrow(limb_type a, limb_type b, limb_type &borrow) noexcept
+    {
+#if defined(MP_OS_BIG_INT_X86_64)
+        if (!std::is_constant_evaluated())
+        {
+            unsigned long long res;
+            borrow = _subborrow_u64(static_cast<unsigned char>(borrow), a, b, &res);
+            return res;
+        }
+#endif
+        limb_type res = a - b;
+        limb_type c = a < b;
+        c |= res < borrow;
+        res -= borrow;
+        borrow = c;
+        return res;
+    }
+
+    /** Full 64x64 -> 128 product, returns low half
+     */
+    constexpr limb_type multiply_wide(limb_type a, limb_type b, limb_type &hi) noexcept
+    {
+#if defined(MP_OS_BIG_INT_HAS_INT128)
+        unsigned __int128 res = static_cast<unsigned __int128>(a) * b;
+        hi = static_cast<limb_type>(res >> limb_bits);
+        return static_cast<limb_type>(res);
+#else
+#   if defined(MP_OS_BIG_INT_X86_64) && defined(_MSC_VER) && !defined(__clang__)
+        if (!std::is_constant_evaluated())
+        {
+            return _umul128(a, b, &hi);
+        }
+#   endif
+        constexpr limb_type half_mask = generate_half_mask<limb_type>();
+        constexpr size_t half_bits = limb_bits / 2;
+
+        limb_type a_lo = a & half_mask, a_hi = a >> half_bits;
+        limb_type b_lo = b & half_mask, b_hi = b >> half_bits;
+
+        limb_type lo_lo = a_lo * b_lo;
+        limb_type hi_lo = a_hi * b_lo;
+        limb_type lo_hi = a_lo * b_hi;
+        limb_type hi_hi = a_hi * b_hi;
+
+        limb_type cross = (lo_lo >> half_bits) + (hi_lo & half_mask) + lo_hi;
+
+        hi = hi_hi + (hi_lo >> half_bits) + (cross >> half_bits);
+        return (cross << half_bits) | (lo_lo & half_mask);
+#endif
     }
+
+    /** (hi * 2^64 + lo) / d, requires hi < d
+     */
+    constexpr limb_type divide_wide(limb_type hi, limb_type lo, limb_type d, limb_type &rem) noexcept
+    {
+#if defined(MP_OS_BIG_INT_HAS_INT128)
+        unsigned __int128 num = (static_cast<unsigned __int128>(hi) << limb_bits) | lo;
+        rem = static_cast<limb_type>(num % d);
+        return static_cast<limb_type>(num / d);
+#else
+        constexpr limb_type half_mask = generate_half_mask<limb_type>();
+        constexpr size_t half_bits = limb_bits / 2;
+        constexpr limb_type half_base = limb_type(1) << half_bits;
+
+        size_t s = 0;
+        while (!(d & (limb_type(1) << (limb_bits - 1))))
+        {
+            d <<= 1;
+            ++s;
+        }
+
+        limb_type d_hi = d >> half_bits, d_lo = d & half_mask;
+        limb_type num_32 = s == 0 ? hi : (hi << s) | (lo >> (limb_bits - s));
+        limb_type num_10 = lo << s;
+        limb_type num_1 = num_10 >> half_bits, num_0 = num_10 & half_mask;
+
+        limb_type q_1 = num_32 / d_hi, rhat = num_32 - q_1 * d_hi;
+        while (q_1 >= half_base || q_1 * d_lo > ((rhat << half_bits) | num_1))
+        {
+            --q_1;
+            rhat += d_hi;
+            if (rhat >= half_base)
+                break;
+        }
+
+        limb_type num_21 = (num_32 << half_bits) + num_1 - q_1 * d;
+
+        limb_type q_0 = num_21 / d_hi;
+        rhat = num_21 - q_0 * d_hi;
+        while (q_0 >= half_base || q_0 * d_lo > ((rhat << half_bits) | num_0))
+        {
+            --q_0;
+            rhat += d_hi;
+            if (rhat >= half_base)
+                break;
+        }
+
+        rem = ((num_21 << half_bits) + num_0 - q_0 * d) >> s;
+        return (q_1 << half_bits) | q_0;
+#endif
+    }
+
+    /** Vector of trivially copyable values that keeps up to N of them inline and allocates through Allocator
+     *  only when grown past that. Allocator propagation follows std::vector with pp_allocator
+     */
+    template<class T, size_t N, class Allocator>
+    requires std::is_trivially_copyable_v<T>
+    class small_vector
+    {
+        static constexpr size_t heap_flag = size_t(1) << (sizeof(size_t) * 8 - 1);
+
+        struct heap_buffer
+        {
+            T *data;
+            size_t capacity;
+        };
+
+        union
+        {
+            T _inline[N];
+            heap_buffer _heap;
+        };
+
+        size_t _size_and_flag; // size, top bit is set while data lives in _heap
+        [[no_unique_address]] Allocator _allocator;
+
+        bool on_heap() const noexcept
+        {
+            return _size_and_flag & heap_flag;
+        }
+
+        void set_size(size_t n) noexcept
+        {
+            _size_and_flag = n | (_size_and_flag & heap_flag);
+        }
+
+        void release() noexcept
+        {
+            if (on_heap())
+                _allocator.deallocate(_heap.data, _heap.capacity);
+            _size_and_flag = 0;
+        }
+
+        /** Moves buffer of other into empty *this, other is left empty
+         */
+        void steal(small_vector &other) noexcept
+        {
+            if (other.on_heap())
+                _heap = other._heap;
+            else
+                std::copy(other._inline, other._inline + other.size(), _inline);
+
+            _size_and_flag = other._size_and_flag;
+            other._size_and_flag = 0;
+        }
+
+    public:
+
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        static constexpr size_t inline_capacity = N;
+
+        explicit small_vector(const Allocator &allocator = Allocator()) noexcept : _heap{nullptr, 0}, _size_and_flag(0), _allocator(allocator) {}
+
+        small_vector(size_t n, const T &value, const Allocator &allocator = Allocator()) : small_vector(allocator)
+        {
+            assign(n, value);
+        }
+
+        explicit small_vector(size_t n, const Allocator &allocator = Allocator()) : small_vector(n, T(), allocator) {}
+
+        template<std::input_iterator It>
+        small_vector(It first, It last, const Allocator &allocator = Allocator()) : small_vector(allocator)
+        {
+            assign(first, last);
+        }
+
+        small_vector(const small_vector &other) : small_vector(std::allocator_traits<Allocator>::select_on_container_copy_construction(other._allocator))
+        {
+            assign(other.begin(), other.end());
+        }
+
+        small_vector(small_vector &&other) noexcept : small_vector(other._allocator)
+        {
+            steal(other);
+        }
+
+        small_vector &operator=(const small_vector &other)
+        {
+            if (this != &other)
+                assign(other.begin(), other.end());
+            return *this;
+        }
+
+        small_vector &operator=(small_vector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                _allocator = other._allocator;
+                steal(other);
+            }
+            return *this;
+        }
+
+        ~small_vector()
+        {
+            release();
+        }
+
+        Allocator get_allocator() const noexcept
+        {
+            return _allocator;
+        }
+
+        T *data() noexcept
+        {
+            return on_heap() ? _heap.data : _inline;
+        }
+
+        const T *data() const noexcept
+        {
+            return on_heap() ? _heap.data : _inline;
+        }
+
+        size_t size() const noexcept
+        {
+            return _size_and_flag & ~heap_flag;
+        }
+
+        size_t capacity() const noexcept
+        {
+            return on_heap() ? _heap.capacity : N;
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        T *begin() noexcept { return data(); }
+        T *end() noexcept { return data() + size(); }
+        const T *begin() const noexcept { return data(); }
+        const T *end() const noexcept { return data() + size(); }
+
+        T &operator[](size_t i) noexcept { return data()[i]; }
+        const T &operator[](size_t i) const noexcept { return data()[i]; }
+
+        T &front() noexcept { return data()[0]; }
+        const T &front() const noexcept { return data()[0]; }
+        T &back() noexcept { return data()[size() - 1]; }
+        const T &back() const noexcept { return data()[size() - 1]; }
+
+        void reserve(size_t n)
+        {
+            if (n <= capacity())
+                return;
+
+            size_t new_capacity = std::max(n, 2 * capacity());
+            T *buffer = _allocator.allocate(new_capacity);
+            size_t n_old = size();
+
+            std::copy(data(), data() + n_old, buffer);
+            release();
+
+            _heap = {buffer, new_capacity};
+            _size_and_flag = n_old | heap_flag;
+        }
+
+        void resize(size_t n, const T &value = T())
+        {
+            size_t n_old = size();
+
+            if (n > n_old)
+            {
+                reserve(n);
+                std::fill(data() + n_old, data() + n, value);
+            }
+
+            set_size(n);
+        }
+
+        void clear() noexcept
+        {
+            set_size(0);
+        }
+
+        void push_back(const T &value)
+        {
+            size_t n = size();
+
+            if (n == capacity())
+            {
+                T copy = value; // value may live in this vector
+                reserve(n + 1);
+                data()[n] = copy;
+            } else
+            {
+                data()[n] = value;
+            }
+
+            set_size(n + 1);
+        }
+
+        void pop_back() noexcept
+        {
+            set_size(size() - 1);
+        }
+
+        void assign(size_t n, const T &value)
+        {
+            T copy = value;
+            clear();
+            resize(n, copy);
+        }
+
+        template<std::input_iterator It>
+        void assign(It first, It last)
+        {
+            if constexpr (std::forward_iterator<It>)
+            {
+                size_t n = static_cast<size_t>(std::distance(first, last));
+                clear();
+                reserve(n);
+                std::copy(first, last, data());
+                set_size(n);
+            } else
+            {
+                clear();
+                for (; first != last; ++first)
+                    push_back(*first);
+            }
+        }
+
+        T *erase(const T *first, const T *last) noexcept
+        {
+            T *pos = data() + (first - data());
+            T *res = std::copy(const_cast<T *>(last), end(), pos);
+            set_size(static_cast<size_t>(res - data()));
+            return pos;
+        }
+    };
 }
 
+template<size_t Bits>
+class fixed_big_int;
+
+class rns_int;
+
+class fraction;
+
+class big_float;
+
 class big_int
 {
     // Call optimise after every operation!!!
     bool _sign; // 1 +  0 -
-    std::vector<unsigned int, pp_allocator<unsigned int>> _digits;
+    __detail::small_vector<unsigned long long, 2, pp_allocator<unsigned long long>> _digits; // little-endian limbs of magnitude, empty for 0, up to 2 limbs inline
 
 public:
 
@@ -58,7 +472,9 @@ public:
     {
         trivial,
         Karatsuba,
-        SchonhageStrassen
+        Toom3, // Toom-3, Toom-3.2 for unbalanced operands
+        Toom4, // Toom-4 above toom4_threshold, Toom-3 below it
+        SchonhageStrassen // three-prime NTT with CRT recombination
     };
 
     enum class division_rule
@@ -68,30 +484,124 @@ public:
         BurnikelZiegler
     };
 
+    enum class primality_test
+    {
+        MillerRabin,
+        BPSW // Miller-Rabin rounds followed by strong Lucas test with Selfridge's parameters
+    };
+
 private:
 
+    template<size_t Bits>
+    friend class fixed_big_int;
+
+    friend class rns_int;
+
+    friend class fraction;
+
+    friend class big_float;
+
     /** Decides type of mult/div that depends on size of lhs and rhs
      */
     multiplication_rule decide_mult(size_t rhs) const noexcept;
     division_rule decide_div(size_t rhs) const noexcept;
 
+    /** Strips leading zero limbs and normalises sign of zero
+     */
+    void optimise() noexcept;
+
+    /** Adds other * 2^(64 * shift) taken with sign other_sign
+     */
+    big_int& plus_assign_signed(const big_int& other, bool other_sign, size_t shift) &;
+
+    /** Adds magnitude [limbs, limbs + n) * 2^(64 * shift) taken with sign, limbs must not point into _digits
+     */
+    big_int& plus_assign_limbs(const unsigned long long* limbs, size_t n, bool sign, size_t shift) &;
+
+    /** Adds lhs * rhs taken with sign product_sign
+     */
+    big_int& addmul_signed(const big_int& lhs, const big_int& rhs, bool product_sign) &;
+
+    /** floor(n^(1 / degree)) for n >= 0 and degree >= 2
+     */
+    static big_int integer_root(const big_int& n, size_t degree);
+
+    /** Product tree over values, elements are moved from
+     */
+    static big_int product_tree(std::vector<big_int>& values, size_t threads);
+
+    /** Splits [begin, end) in up to threads ranges run on shared pool, calling thread takes the first one.
+     *  Lets element-wise loops of rns_int use the same pool as multiplication
+     */
+    static void parallel_range(size_t begin, size_t end, size_t threads, const std::function<void(size_t, size_t)> &body);
+
 public:
 
-    using value_type = unsigned int;
+    /** Limb type. Radix of the number is 2^64, constructors from std::vector<unsigned int> still take radix 2^32 digits
+     */
+    using value_type = __detail::limb_type;
+
+    /** Crossover points (in limbs of the shorter operand) between multiplication algorithms.
+     *  Defaults are measured on x86-64, they may be tuned for the target machine
+     */
+    static inline size_t karatsuba_threshold = 28;
+    static inline size_t karatsuba_square_threshold = 48;
+    static inline size_t toom3_threshold = 300;
+    static inline size_t toom4_threshold = 700;
+    static inline size_t ntt_threshold = 1500;
+
+    /** Divisor length (in limbs) from which division switches from schoolbook to Burnikel-Ziegler
+     */
+    static inline size_t burnikel_ziegler_threshold = 60;
+
+    /** Divisor length (in limbs) from which big_int::divisor reduces by precomputed Newton reciprocal (Barrett) instead of schoolbook
+     */
+    static inline size_t newton_threshold = 150;
+
+    /** Operand length (in limbs) from which gcd and xgcd reduce by subquadratic half-gcd instead of Lehmer steps
+     */
+    static inline size_t hgcd_threshold = 100;
+
+    class divisor;
+
+    class product_expression;
+
+    /** Default number of threads used by one multiplication, operands shorter than parallel_threshold limbs
+     *  are always multiplied on the calling thread. Tasks run on a pool shared by all big_ints
+     */
+    static inline size_t parallelism = 1;
+    static inline size_t parallel_threshold = 2048;
+
+    /** Recreates shared pool with given number of threads, 0 means std::thread::hardware_concurrency()
+     */
+    static void set_thread_pool_size(size_t threads);
+
+    /** Tuning table of all thresholds above, one "name value" pair per line, '#' starts a comment.
+     *  Thresholds missing from the table keep their values. The table for a machine is written by
+     *  mp_os_arthmtc_bg_intgr_bnchmrks_attn
+     *  @throws std::invalid_argument on unknown name or malformed value
+     */
+    static void load_tuning(std::istream &stream);
+
+    /** @throws std::runtime_error if file cannot be opened
+     */
+    static void load_tuning(const std::string &path);
+
+    static void save_tuning(std::ostream &stream);
 
     template<class alloc>
-    explicit big_int(const std::vector<unsigned int, alloc> &digits, bool sign = true, pp_allocator<unsigned int> allocator = pp_allocator<unsigned int>());
+    explicit big_int(const std::vector<unsigned int, alloc> &digits, bool sign = true, pp_allocator<value_type> allocator = pp_allocator<value_type>());
 
     explicit big_int(const std::vector<unsigned int, pp_allocator<unsigned int>> &digits, bool sign = true);
 
-    explicit big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits, bool sign = true) noexcept;
+    explicit big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits, bool sign = true);
 
-    explicit big_int(const std::string& num, unsigned int radix = 10, pp_allocator<unsigned int> = pp_allocator<unsigned int>());
+    explicit big_int(const std::string& num, unsigned int radix = 10, pp_allocator<value_type> = pp_allocator<value_type>());
 
     template<std::integral Num>
-    big_int(Num d, pp_allocator<unsigned int> = pp_allocator<unsigned int>());
+    big_int(Num d, pp_allocator<value_type> = pp_allocator<value_type>());
 
-    big_int(pp_allocator<unsigned int> = pp_allocator<unsigned int>());
+    big_int(pp_allocator<value_type> = pp_allocator<value_type>());
 
     explicit operator bool() const noexcept; //false if 0 , else true
 
@@ -103,7 +613,7 @@ public:
 
     big_int& operator+=(const big_int& other) &;
 
-    /** Shift will be needed for multiplication implementation
+    /** Shift will be needed for multiplication implementation, it is measured in limbs
      *  @example Shift = 0: 111 + 222 = 333
      *  @example Shift = 1: 111 + 222 = 2331
      */
@@ -118,35 +628,125 @@ public:
      */
     big_int& operator*=(const big_int& other) &;
 
-    big_int& multiply_assign(const big_int& other, multiplication_rule rule = multiplication_rule::trivial) &;
+    /** threads is a hint for Karatsuba and SchonhageStrassen rules, 0 means big_int::parallelism
+     */
+    big_int& multiply_assign(const big_int& other, multiplication_rule rule = multiplication_rule::trivial, size_t threads = 0) &;
 
+    /** Division truncates towards zero, remainder has sign of dividend
+     *  @throws std::logic_error on division by zero
+     */
     big_int& operator/=(const big_int& other) &;
 
-    big_int& divide_assign(const big_int& other, division_rule rule = division_rule::trivial) &;
+    /** threads is a hint for BurnikelZiegler rule (its subproducts), 0 means big_int::parallelism
+     */
+    big_int& divide_assign(const big_int& other, division_rule rule = division_rule::trivial, size_t threads = 0) &;
 
     big_int& operator%=(const big_int& other) &;
 
-    big_int& modulo_assign(const big_int& other, division_rule rule = division_rule::trivial) &;
+    big_int& modulo_assign(const big_int& other, division_rule rule = division_rule::trivial, size_t threads = 0) &;
+
+    /** Quotient of division that is known to be exact, by Jebelean's 2-adic algorithm: quotient limbs are found
+     *  from the low end with no trial quotient correction. Result is unspecified if other does not divide this
+     *  @throws std::logic_error on division by zero
+     */
+    big_int& divexact_assign(const big_int& other) &;
+
+    big_int divexact(const big_int& other) const;
+
+    /** Fused operations, product is accumulated into this without temporary big_int.
+     *  A single limb factor is multiplied straight into the limbs of this
+     *  @example addmul: this += lhs * rhs
+     *  @example submul: this -= lhs * rhs
+     */
+    big_int& addmul(const big_int& lhs, const big_int& rhs) &;
+
+    big_int& submul(const big_int& lhs, const big_int& rhs) &;
+
+    /** this = this * multiplier + addend
+     */
+    big_int& mul_add_assign(const big_int& multiplier, const big_int& addend) &;
+
+    /** Quotient and remainder of one division, written into existing outputs so their storage is reused.
+     *  Either output may alias dividend or d, but not each other
+     *  @throws std::logic_error on division by zero
+     *  @throws std::invalid_argument if quotient and remainder are the same object
+     */
+    static void divmod(const big_int& dividend, const big_int& d, big_int& quotient, big_int& remainder);
+
+    static void divmod(const big_int& dividend, const big_int& d, big_int& quotient, big_int& remainder, division_rule rule, size_t threads = 0);
+
+    /** Deferred lhs * rhs. Assigned to a big_int it multiplies into the storage the destination already has,
+     *  with += and -= it becomes addmul and submul
+     */
+    static product_expression product(const big_int& lhs, const big_int& rhs) noexcept;
+
+    /** Product of all values by balanced product tree: subtrees are split by limb count, so fast multiplication
+     *  gets operands of equal length. Tree is walked on calling thread and multiplications use shared pool when
+     *  threads > 1 (0 means big_int::parallelism), so memory resource of values is only called from one thread.
+     *  Empty range gives 1
+     */
+    template<std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>, big_int>
+    static big_int product(Range&& values, size_t threads = 0);
 
-    big_int operator+(const big_int& other) const;
-    big_int operator-(const big_int& other) const;
-    big_int operator*(const big_int& other) const;
-    big_int operator/(const big_int& other) const;
-    big_int operator%(const big_int& other) const;
+    /** Luschny's prime swing: n! = (floor(n / 2)!)^2 * swing(n), swing(n) is collected from prime powers
+     *  by product tree
+     */
+    static big_int factorial(size_t n, size_t threads = 0);
+
+    /** Prime factorization by Kummer's theorem, short k divides falling factorial by k! exactly. 0 for k > n
+     */
+    static big_int binomial(size_t n, size_t k, size_t threads = 0);
+
+    big_int& operator=(const product_expression& expression) &;
+
+    big_int& operator+=(const product_expression& expression) &;
+
+    big_int& operator-=(const product_expression& expression) &;
+
+    /** Operators on rvalues reuse storage of the expiring operand
+     */
+    big_int operator+(const big_int& other) const &;
+    big_int operator+(const big_int& other) &&;
+    big_int operator+(big_int&& other) const &;
+    big_int operator+(big_int&& other) &&;
+
+    big_int operator-(const big_int& other) const &;
+    big_int operator-(const big_int& other) &&;
+    big_int operator-(big_int&& other) const &;
+    big_int operator-(big_int&& other) &&;
+
+    big_int operator*(const big_int& other) const &;
+    big_int operator*(const big_int& other) &&;
+    big_int operator*(big_int&& other) const &;
+    big_int operator*(big_int&& other) &&;
+
+    big_int operator/(const big_int& other) const &;
+    big_int operator/(const big_int& other) &&;
+
+    big_int operator%(const big_int& other) const &;
+    big_int operator%(const big_int& other) &&;
 
     std::strong_ordering operator<=>(const big_int& other) const noexcept;
 
     bool operator==(const big_int& other) const noexcept;
 
+    /** Shifts are arithmetic: << multiplies by 2^shift, >> is floor division by 2^shift
+     */
     big_int& operator<<=(size_t shift) &;
 
     big_int& operator>>=(size_t shift) &;
 
 
-    big_int operator<<(size_t shift) const;
-    big_int operator>>(size_t shift) const;
+    big_int operator<<(size_t shift) const &;
+    big_int operator<<(size_t shift) &&;
+    big_int operator>>(size_t shift) const &;
+    big_int operator>>(size_t shift) &&;
 
-    big_int operator~() const;
+    /** Bitwise operations behave as on infinite two's complement representation, so ~x == -x - 1
+     */
+    big_int operator~() const &;
+    big_int operator~() &&;
 
     big_int& operator&=(const big_int& other) &;
 
@@ -155,27 +755,232 @@ public:
     big_int& operator^=(const big_int& other) &;
 
 
-    big_int operator&(const big_int& other) const;
-    big_int operator|(const big_int& other) const;
-    big_int operator^(const big_int& other) const;
+    big_int operator&(const big_int& other) const &;
+    big_int operator&(const big_int& other) &&;
+    big_int operator|(const big_int& other) const &;
+    big_int operator|(const big_int& other) &&;
+    big_int operator^(const big_int& other) const &;
+    big_int operator^(const big_int& other) &&;
 
+    /** Stream operators honour std::hex and std::oct. Input is parsed in blocks while it is read,
+     *  extraction stops at first character that is not a digit
+     */
     friend std::ostream &operator<<(std::ostream &stream, big_int const &value);
 
     friend std::istream &operator>>(std::istream &stream, big_int &value);
 
-    std::string to_string() const;
+    /** Divide-and-conquer conversion by cached powers of radix, linear for powers of two
+     */
+    std::string to_string(unsigned int radix = 10) const;
+
+    /** Magnitude as raw bytes without radix conversion, sign is kept separately.
+     *  On little-endian hosts little-endian order is a plain copy of limbs
+     */
+    size_t export_size() const noexcept;
+
+    /** Writes export_size() bytes of magnitude, the rest of bytes is filled with zeros on the high side
+     *  @throws std::invalid_argument if bytes is shorter than export_size()
+     */
+    void export_limbs(std::span<std::byte> bytes, std::endian order = std::endian::little) const;
+
+    big_int& import_limbs(std::span<const std::byte> bytes, std::endian order = std::endian::little, bool sign = true) &;
+
+    /** Length-prefixed binary format: LEB128 varint of (byte count << 1 | negative), then little-endian bytes of magnitude.
+     *  Zero takes one byte. Reading sets failbit on truncated or malformed input and leaves value unchanged
+     */
+    void write_binary(std::ostream &stream) const;
+
+    big_int& read_binary(std::istream &stream) &;
+
+    /** Modular arithmetic, results are in [0, modulus)
+     *  @throws std::logic_error if modulus is not positive
+     */
+    big_int mul_mod(const big_int& other, const big_int& modulus) const;
+
+    /** @throws std::logic_error if value and modulus are not coprime
+     */
+    big_int inverse_mod(const big_int& modulus) const;
+
+    /** Montgomery exponentiation with sliding window, negative exponent raises inverse_mod.
+     *  constant_time uses fixed windows and masked table lookups, so timing depends only on sizes of operands
+     *  @throws std::invalid_argument if constant_time is requested for even modulus
+     */
+    big_int pow_mod(const big_int& exponent, const big_int& modulus, bool constant_time = false) const;
+
+    /** Greatest common divisor, non-negative, gcd(0, 0) = 0. Binary algorithm for operands of up to two limbs,
+     *  Lehmer's algorithm below hgcd_threshold limbs and subquadratic half-gcd above it
+     */
+    static big_int gcd(const big_int& a, const big_int& b);
+
+    /** Also finds cofactors with a * s + b * t = gcd(a, b) and |s| <= |b| / (2 * gcd), for zero b s is sign of a
+     */
+    static big_int xgcd(const big_int& a, const big_int& b, big_int& s, big_int& t);
+
+    /** Integer roots by Newton's method with precision doubling: root of the leading half of bits is found
+     *  recursively and refined by one Newton step, so square root costs about two divisions of the full value
+     *  by its root: one at top level and as much again over all recursion levels
+     *  Result is floor of root, truncated toward zero for negative value and odd degree
+     *  @throws std::invalid_argument if value is negative for even degree or degree is zero
+     */
+    big_int isqrt() const;
+
+    big_int iroot(size_t degree) const;
+
+    /** Square test is filtered by residue modulo 64 before square root is taken
+     */
+    bool is_perfect_square() const;
+
+    /** true if value is x^k for some k >= 2, 0 and 1 included. Tries iroot for prime degrees up to bit length
+     */
+    bool is_perfect_power() const;
+
+    /** Trial division by primes below 2^11, then Miller-Rabin in Montgomery form with base 2 and rounds - 1
+     *  random bases; BPSW adds strong Lucas test after them. Exact for values below 2^64, a composite passes
+     *  rounds of Miller-Rabin with probability below 4^-rounds. Negative values, 0 and 1 are not prime
+     */
+    bool is_probable_prime(size_t rounds = 25, primality_test test = primality_test::MillerRabin) const;
+
+    /** Uniform in [0, 2^bits), limbs are filled from generator directly
+     */
+    template<std::uniform_random_bit_generator Generator>
+    static big_int random_bits(size_t bits, Generator& generator);
+
+    /** Uniform in [0, bound) by rejection from random_bits of bound's length, less than two draws on average
+     *  @throws std::invalid_argument if bound is not positive
+     */
+    template<std::uniform_random_bit_generator Generator>
+    static big_int random_below(const big_int& bound, Generator& generator);
+};
+
+/** Divisor prepared for repeated division: normalised once and, when long enough, with Newton reciprocal
+ *  floor(B^2n / d), so each division costs about two multiplications. Results match operator/ and operator%
+ */
+class big_int::divisor
+{
+    big_int _value;
+    unsigned int _shift;
+    __detail::small_vector<value_type, 2, pp_allocator<value_type>> _normalised; // _value << _shift, top bit set
+    __detail::small_vector<value_type, 2, pp_allocator<value_type>> _reciprocal; // n + 1 limbs, empty below newton_threshold
+
+    void divide(const big_int& dividend, big_int* quotient, big_int* remainder) const;
+
+public:
+
+    /** @throws std::logic_error if value is zero
+     */
+    explicit divisor(const big_int& value);
+
+    const big_int& value() const noexcept;
+
+    big_int div(const big_int& dividend) const;
+
+    big_int mod(const big_int& dividend) const;
+
+    /** @return quotient and remainder
+     */
+    std::pair<big_int, big_int> divmod(const big_int& dividend) const;
+};
+
+/** Result of big_int::product. Holds references to operands, so it must not outlive the full expression
+ */
+class big_int::product_expression
+{
+    const big_int& _lhs;
+    const big_int& _rhs;
+
+    product_expression(const big_int& lhs, const big_int& rhs) noexcept;
+
+    friend class big_int;
+
+public:
+
+    operator big_int() const;
 };
 
+template<std::ranges::input_range Range>
+    requires std::convertible_to<std::ranges::range_reference_t<Range>, big_int>
+big_int big_int::product(Range&& values, size_t threads)
+{
+    std::vector<big_int> factors;
+
+    if constexpr (std::ranges::sized_range<Range>)
+        factors.reserve(std::ranges::size(values));
+
+    for (auto&& value : values)
+        factors.emplace_back(std::forward<decltype(value)>(value));
+
+    return product_tree(factors, threads);
+}
+
+template<std::uniform_random_bit_generator Generator>
+big_int big_int::random_bits(size_t bits, Generator& generator)
+{
+    std::uniform_int_distribution<value_type> distribution;
+    big_int res;
+
+    res._digits.resize((bits + __detail::limb_bits - 1) / __detail::limb_bits);
+
+    for (auto &digit : res._digits)
+        digit = distribution(generator);
+
+    if (bits % __detail::limb_bits != 0)
+        res._digits.back() &= (value_type(1) << (bits % __detail::limb_bits)) - 1;
+
+    res.optimise();
+    return res;
+}
+
+template<std::uniform_random_bit_generator Generator>
+big_int big_int::random_below(const big_int& bound, Generator& generator)
+{
+    if (!bound._sign || bound._digits.empty())
+        throw std::invalid_argument("big_int: bound of random value must be positive");
+
+    size_t bits = (bound._digits.size() - 1) * __detail::limb_bits + std::bit_width(bound._digits.back());
+    big_int res;
+
+    do
+    {
+        res = random_bits(bits, generator);
+    } while (res >= bound);
+
+    return res;
+}
+
 template<class alloc>
-big_int::big_int(const std::vector<unsigned int, alloc> &digits, bool sign, pp_allocator<unsigned int> allocator)
+big_int::big_int(const std::vector<unsigned int, alloc> &digits, bool sign, pp_allocator<value_type> allocator) : _sign(sign), _digits(allocator)
 {
-    throw not_implemented("template<class alloc> big_int::big_int(const std::vector<unsigned int, alloc> &digits, bool sign, pp_allocator<unsigned int> allocator)", "your code should be here...");
+    _digits.resize((digits.size() + 1) / 2, 0);
+
+    for (size_t i = 0; i < digits.size(); ++i)
+    {
+        _digits[i / 2] |= static_cast<value_type>(digits[i]) << (32 * (i % 2));
+    }
+
+    optimise();
 }
 
 template<std::integral Num>
-big_int::big_int(Num d, pp_allocator<unsigned int>)
+big_int::big_int(Num d, pp_allocator<value_type> allocator) : _sign(d >= 0), _digits(allocator)
 {
-    throw not_implemented("template<std::integral Num>big_int::big_int(Num, pp_allocator<unsigned int>)", "your code should be here...");
+    using unsigned_num = std::make_unsigned_t<Num>;
+
+    unsigned_num magnitude = d >= 0 ? static_cast<unsigned_num>(d) : static_cast<unsigned_num>(unsigned_num(0) - static_cast<unsigned_num>(d));
+
+    if constexpr (sizeof(unsigned_num) <= sizeof(value_type))
+    {
+        if (magnitude != 0)
+            _digits.push_back(static_cast<value_type>(magnitude));
+    } else
+    {
+        while (magnitude != 0)
+        {
+            _digits.push_back(static_cast<value_type>(magnitude));
+            magnitude >>= __detail::limb_bits;
+        }
+    }
+
+    optimise();
 }
 
 big_int operator""_bi(unsigned long long n);
@@ -0,0 +1,605 @@
+#ifndef MP_OS_FIXED_BIG_INT_H
+#define MP_OS_FIXED_BIG_INT_H
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <compare>
+#include <utility>
+#include <big_int.h>
+
+namespace __detail
+{
+    /** Calls f(std::integral_constant<size_t, I>{}) for I in [0, N), unrolled by fold expression
+     */
+    template<size_t N, class F>
+    constexpr void unrolled_for(F &&f)
+    {
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (f(std::integral_constant<size_t, I>{}), ...);
+        }(std::make_index_sequence<N>{});
+    }
+
+    constexpr int fixed_digit(char ch) noexcept
+    {
+        if (ch >= '0' && ch <= '9')
+            return ch - '0';
+        if (ch >= 'a' && ch <= 'z')
+            return ch - 'a' + 10;
+        if (ch >= 'A' && ch <= 'Z')
+            return ch - 'A' + 10;
+        return -1;
+    }
+}
+
+/** Signed integer of Bits bits in two's complement, limbs are kept on the stack. Everything but conversions to
+ *  big_int and strings is constexpr, loops over limbs are unrolled. Overflow wraps modulo 2^Bits
+ */
+template<size_t Bits>
+class fixed_big_int final
+{
+    static_assert(Bits != 0 && Bits % __detail::limb_bits == 0, "fixed_big_int: Bits must be a positive multiple of 64");
+
+public:
+
+    using value_type = __detail::limb_type;
+
+    static constexpr size_t limb_count = Bits / __detail::limb_bits;
+
+private:
+
+    std::array<value_type, limb_count> _limbs{}; // little-endian
+
+    template<size_t> friend class fixed_big_int;
+
+    static constexpr value_type extension(bool negative) noexcept
+    {
+        return negative ? ~value_type(0) : 0;
+    }
+
+    /** this = this * m + a, returns carry out of top limb
+     */
+    constexpr value_type mul_add_1(value_type m, value_type a) noexcept
+    {
+        value_type carry = a;
+
+        __detail::unrolled_for<limb_count>([&](auto i)
+        {
+            value_type hi, c = 0;
+            value_type lo = __detail::multiply_wide(_limbs[i], m, hi);
+            _limbs[i] = __detail::add_with_carry(lo, carry, c);
+            carry = hi + c;
+        });
+
+        return carry;
+    }
+
+    /** Knuth's division of magnitudes, quotient and remainder are taken as unsigned
+     *  @throws std::logic_error on division by zero
+     */
+    static constexpr void divide_unsigned(const fixed_big_int &a, const fixed_big_int &b, fixed_big_int *quotient, fixed_big_int *remainder)
+    {
+        size_t an = limb_count, bn = limb_count;
+
+        while (an > 0 && a._limbs[an - 1] == 0)
+            --an;
+        while (bn > 0 && b._limbs[bn - 1] == 0)
+            --bn;
+
+        if (bn == 0)
+            throw std::logic_error("fixed_big_int: division by zero");
+
+        fixed_big_int q, r;
+
+        if (bn == 1)
+        {
+            value_type rem = 0;
+
+            for (size_t i = an; i-- > 0;)
+                q._limbs[i] = __detail::divide_wide(rem, a._limbs[i], b._limbs[0], rem);
+
+            r._limbs[0] = rem;
+        } else if (an < bn)
+        {
+            r = a;
+        } else
+        {
+            unsigned int shift = std::countl_zero(b._limbs[bn - 1]);
+            std::array<value_type, limb_count> v{};
+            std::array<value_type, limb_count + 1> u{};
+
+            for (size_t i = 0; i < bn; ++i)
+                v[i] = (b._limbs[i] << shift) | (shift != 0 && i > 0 ? b._limbs[i - 1] >> (__detail::limb_bits - shift) : 0);
+            for (size_t i = 0; i <= an; ++i)
+            {
+                value_type low = i > 0 && shift != 0 ? a._limbs[i - 1] >> (__detail::limb_bits - shift) : 0;
+                u[i] = (i < an ? a._limbs[i] << shift : 0) | low;
+            }
+
+            for (size_t j = an - bn + 1; j-- > 0;)
+            {
+                // estimate from top two limbs, corrected by the third: at most one add back remains
+                value_type qhat, rhat = 0;
+                bool rhat_overflow = false;
+
+                if (u[j + bn] >= v[bn - 1])
+                {
+                    qhat = ~value_type(0);
+                    value_type c = 0;
+                    rhat = __detail::add_with_carry(u[j + bn - 1], v[bn - 1], c);
+                    rhat_overflow = c != 0;
+                } else
+                {
+                    qhat = __detail::divide_wide(u[j + bn], u[j + bn - 1], v[bn - 1], rhat);
+                }
+
+                while (!rhat_overflow)
+                {
+                    value_type hi, lo = __detail::multiply_wide(qhat, v[bn - 2], hi);
+
+                    if (hi < rhat || (hi == rhat && lo <= u[j + bn - 2]))
+                        break;
+
+                    --qhat;
+                    value_type c = 0;
+                    rhat = __detail::add_with_carry(rhat, v[bn - 1], c);
+                    rhat_overflow = c != 0;
+                }
+
+                value_type carry = 0, borrow = 0;
+
+                for (size_t i = 0; i < bn; ++i)
+                {
+                    value_type hi, c = 0;
+                    value_type lo = __detail::add_with_carry(__detail::multiply_wide(qhat, v[i], hi), carry, c);
+                    carry = hi + c;
+                    u[j + i] = __detail::sub_with_borrow(u[j + i], lo, borrow);
+                }
+
+                u[j + bn] = __detail::sub_with_borrow(u[j + bn], carry, borrow);
+
+                if (borrow != 0)
+                {
+                    --qhat;
+                    value_type c = 0;
+
+                    for (size_t i = 0; i < bn; ++i)
+                        u[j + i] = __detail::add_with_carry(u[j + i], v[i], c);
+
+                    u[j + bn] += c;
+                }
+
+                q._limbs[j] = qhat;
+            }
+
+            for (size_t i = 0; i < bn; ++i)
+                r._limbs[i] = (u[i] >> shift) | (shift != 0 ? u[i + 1] << (__detail::limb_bits - shift) : 0);
+        }
+
+        if (quotient != nullptr)
+            *quotient = q;
+        if (remainder != nullptr)
+            *remainder = r;
+    }
+
+    /** Truncating signed division, remainder takes sign of dividend
+     */
+    static constexpr void divide(const fixed_big_int &a, const fixed_big_int &b, fixed_big_int *quotient, fixed_big_int *remainder)
+    {
+        bool a_negative = a.is_negative(), b_negative = b.is_negative();
+
+        divide_unsigned(a_negative ? -a : a, b_negative ? -b : b, quotient, remainder);
+
+        if (quotient != nullptr && a_negative != b_negative)
+            *quotient = -*quotient;
+        if (remainder != nullptr && a_negative)
+            *remainder = -*remainder;
+    }
+
+public:
+
+    constexpr fixed_big_int() noexcept = default;
+
+    template<std::integral Num>
+    constexpr fixed_big_int(Num value) noexcept
+    {
+        bool negative = false;
+
+        if constexpr (std::is_signed_v<Num>)
+            negative = value < 0;
+
+        _limbs[0] = static_cast<value_type>(value);
+
+        for (size_t i = 1; i < limb_count; ++i)
+            _limbs[i] = extension(negative);
+    }
+
+    /** Widening keeps the value, narrowing keeps low Bits bits
+     */
+    template<size_t Other> requires (Other < Bits)
+    constexpr fixed_big_int(const fixed_big_int<Other> &other) noexcept
+    {
+        for (size_t i = 0; i < limb_count; ++i)
+            _limbs[i] = i < other.limb_count ? other._limbs[i] : extension(other.is_negative());
+    }
+
+    template<size_t Other> requires (Other > Bits)
+    constexpr explicit fixed_big_int(const fixed_big_int<Other> &other) noexcept
+    {
+        for (size_t i = 0; i < limb_count; ++i)
+            _limbs[i] = other._limbs[i];
+    }
+
+    /** Optional sign and digits in radix from 2 to 36, value is taken modulo 2^Bits
+     *  @throws std::invalid_argument if there are no digits or a character is not a digit in radix
+     */
+    constexpr explicit fixed_big_int(std::string_view digits, unsigned int radix = 10)
+    {
+        if (radix < 2 || radix > 36)
+            throw std::invalid_argument("fixed_big_int: radix must be in [2, 36]");
+
+        bool negative = !digits.empty() && digits.front() == '-';
+
+        if (!digits.empty() && (digits.front() == '-' || digits.front() == '+'))
+            digits.remove_prefix(1);
+
+        if (digits.empty())
+            throw std::invalid_argument("fixed_big_int: no digits");
+
+        for (char ch : digits)
+        {
+            int digit = __detail::fixed_digit(ch);
+
+            if (digit < 0 || static_cast<unsigned int>(digit) >= radix)
+                throw std::invalid_argument("fixed_big_int: invalid digit");
+
+            mul_add_1(radix, static_cast<value_type>(digit));
+        }
+
+        if (negative)
+            *this = -*this;
+    }
+
+    /** Low Bits bits of value in two's complement
+     */
+    explicit fixed_big_int(const big_int &value) noexcept
+    {
+        for (size_t i = 0; i < limb_count && i < value._digits.size(); ++i)
+            _limbs[i] = value._digits[i];
+
+        if (!value._sign)
+            *this = -*this;
+    }
+
+    explicit operator big_int() const
+    {
+        bool negative = is_negative();
+        fixed_big_int magnitude = negative ? -*this : *this;
+        big_int res;
+
+        res._digits.resize(limb_count);
+        std::copy(magnitude._limbs.begin(), magnitude._limbs.end(), res._digits.begin());
+        res._sign = !negative;
+        res.optimise();
+        return res;
+    }
+
+    template<std::integral Num> requires (!std::same_as<Num, bool>)
+    constexpr explicit operator Num() const noexcept
+    {
+        return static_cast<Num>(_limbs[0]);
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        for (value_type limb : _limbs)
+        {
+            if (limb != 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    constexpr value_type limb(size_t index) const noexcept
+    {
+        return _limbs[index];
+    }
+
+    constexpr bool is_negative() const noexcept
+    {
+        return (_limbs[limb_count - 1] >> (__detail::limb_bits - 1)) != 0;
+    }
+
+    /** Bits of magnitude, 0 for 0
+     */
+    constexpr size_t bit_length() const noexcept
+    {
+        fixed_big_int magnitude = is_negative() ? -*this : *this;
+
+        for (size_t i = limb_count; i-- > 0;)
+        {
+            if (magnitude._limbs[i] != 0)
+                return i * __detail::limb_bits + std::bit_width(magnitude._limbs[i]);
+        }
+
+        return 0;
+    }
+
+    std::string to_string(unsigned int radix = 10) const
+    {
+        return static_cast<big_int>(*this).to_string(radix);
+    }
+
+public:
+
+    constexpr fixed_big_int &operator+=(const fixed_big_int &other) & noexcept
+    {
+        value_type carry = 0;
+
+        __detail::unrolled_for<limb_count>([&](auto i)
+        {
+            _limbs[i] = __detail::add_with_carry(_limbs[i], other._limbs[i], carry);
+        });
+
+        return *this;
+    }
+
+    constexpr fixed_big_int &operator-=(const fixed_big_int &other) & noexcept
+    {
+        value_type borrow = 0;
+
+        __detail::unrolled_for<limb_count>([&](auto i)
+        {
+            _limbs[i] = __detail::sub_with_borrow(_limbs[i], other._limbs[i], borrow);
+        });
+
+        return *this;
+    }
+
+    /** Low half of product by columns (Comba) into three-limb accumulator, top column needs only low halves.
+     *  Two's complement makes it the same for signed values
+     */
+    constexpr fixed_big_int &operator*=(const fixed_big_int &other) & noexcept
+    {
+        std::array<value_type, limb_count> res{};
+        value_type acc0 = 0, acc1 = 0, acc2 = 0;
+
+        __detail::unrolled_for<limb_count>([&](auto k)
+        {
+            constexpr size_t column = decltype(k)::value;
+
+            __detail::unrolled_for<column + 1>([&](auto i)
+            {
+                constexpr size_t j = column - decltype(i)::value;
+
+                if constexpr (column + 1 == limb_count)
+                {
+                    acc0 += _limbs[i] * other._limbs[j];
+                } else
+                {
+#if defined(MP_OS_BIG_INT_HAS_INT128)
+                    // two low limbs of accumulator as one 128-bit value keep the dependency chain short
+                    unsigned __int128 product = static_cast<unsigned __int128>(_limbs[i]) * other._limbs[j];
+                    unsigned __int128 sum = ((static_cast<unsigned __int128>(acc1) << __detail::limb_bits) | acc0) + product;
+                    acc2 += sum < product;
+                    acc0 = static_cast<value_type>(sum);
+                    acc1 = static_cast<value_type>(sum >> __detail::limb_bits);
+#else
+                    value_type hi, carry = 0;
+                    value_type lo = __detail::multiply_wide(_limbs[i], other._limbs[j], hi);
+                    acc0 = __detail::add_with_carry(acc0, lo, carry);
+                    acc1 = __detail::add_with_carry(acc1, hi, carry);
+                    acc2 += carry;
+#endif
+                }
+            });
+
+            res[column] = acc0;
+            acc0 = acc1;
+            acc1 = acc2;
+            acc2 = 0;
+        });
+
+        _limbs = res;
+        return *this;
+    }
+
+    /** @throws std::logic_error on division by zero
+     */
+    constexpr fixed_big_int &operator/=(const fixed_big_int &other) &
+    {
+        divide(*this, other, this, nullptr);
+        return *this;
+    }
+
+    constexpr fixed_big_int &operator%=(const fixed_big_int &other) &
+    {
+        divide(*this, other, nullptr, this);
+        return *this;
+    }
+
+    constexpr fixed_big_int &operator&=(const fixed_big_int &other) & noexcept
+    {
+        __detail::unrolled_for<limb_count>([&](auto i) { _limbs[i] &= other._limbs[i]; });
+        return *this;
+    }
+
+    constexpr fixed_big_int &operator|=(const fixed_big_int &other) & noexcept
+    {
+        __detail::unrolled_for<limb_count>([&](auto i) { _limbs[i] |= other._limbs[i]; });
+        return *this;
+    }
+
+    constexpr fixed_big_int &operator^=(const fixed_big_int &other) & noexcept
+    {
+        __detail::unrolled_for<limb_count>([&](auto i) { _limbs[i] ^= other._limbs[i]; });
+        return *this;
+    }
+
+    constexpr fixed_big_int &operator<<=(size_t shift) & noexcept
+    {
+        size_t limbs = shift / __detail::limb_bits;
+        unsigned int bits = shift % __detail::limb_bits;
+
+        for (size_t i = limb_count; i-- > 0;)
+        {
+            value_type high = i >= limbs ? _limbs[i - limbs] << bits : 0;
+            value_type low = i >= limbs + 1 && bits != 0 ? _limbs[i - limbs - 1] >> (__detail::limb_bits - bits) : 0;
+            _limbs[i] = high | low;
+        }
+
+        return *this;
+    }
+
+    /** Arithmetic shift, rounds toward minus infinity
+     */
+    constexpr fixed_big_int &operator>>=(size_t shift) & noexcept
+    {
+        value_type fill = extension(is_negative());
+        size_t limbs = shift / __detail::limb_bits;
+        unsigned int bits = shift % __detail::limb_bits;
+
+        for (size_t i = 0; i < limb_count; ++i)
+        {
+            value_type low = i + limbs < limb_count ? _limbs[i + limbs] : fill;
+            value_type high = i + limbs + 1 < limb_count ? _limbs[i + limbs + 1] : fill;
+            _limbs[i] = bits == 0 ? low : (low >> bits) | (high << (__detail::limb_bits - bits));
+        }
+
+        return *this;
+    }
+
+    constexpr fixed_big_int &operator++() & noexcept
+    {
+        return *this += fixed_big_int(1);
+    }
+
+    constexpr fixed_big_int &operator--() & noexcept
+    {
+        return *this -= fixed_big_int(1);
+    }
+
+    constexpr fixed_big_int operator++(int) & noexcept
+    {
+        fixed_big_int res = *this;
+        ++*this;
+        return res;
+    }
+
+    constexpr fixed_big_int operator--(int) & noexcept
+    {
+        fixed_big_int res = *this;
+        --*this;
+        return res;
+    }
+
+    constexpr fixed_big_int operator~() const noexcept
+    {
+        fixed_big_int res;
+        __detail::unrolled_for<limb_count>([&](auto i) { res._limbs[i] = ~_limbs[i]; });
+        return res;
+    }
+
+    constexpr fixed_big_int operator-() const noexcept
+    {
+        fixed_big_int res = ~*this;
+        return ++res;
+    }
+
+    constexpr fixed_big_int operator+() const noexcept
+    {
+        return *this;
+    }
+
+    /** Operators are hidden friends, so integers and narrower fixed_big_int convert implicitly on either side
+     */
+    friend constexpr fixed_big_int operator+(fixed_big_int lhs, const fixed_big_int &rhs) noexcept { lhs += rhs; return lhs; }
+    friend constexpr fixed_big_int operator-(fixed_big_int lhs, const fixed_big_int &rhs) noexcept { lhs -= rhs; return lhs; }
+    friend constexpr fixed_big_int operator*(fixed_big_int lhs, const fixed_big_int &rhs) noexcept { lhs *= rhs; return lhs; }
+    friend constexpr fixed_big_int operator/(fixed_big_int lhs, const fixed_big_int &rhs) { lhs /= rhs; return lhs; }
+    friend constexpr fixed_big_int operator%(fixed_big_int lhs, const fixed_big_int &rhs) { lhs %= rhs; return lhs; }
+    friend constexpr fixed_big_int operator&(fixed_big_int lhs, const fixed_big_int &rhs) noexcept { lhs &= rhs; return lhs; }
+    friend constexpr fixed_big_int operator|(fixed_big_int lhs, const fixed_big_int &rhs) noexcept { lhs |= rhs; return lhs; }
+    friend constexpr fixed_big_int operator^(fixed_big_int lhs, const fixed_big_int &rhs) noexcept { lhs ^= rhs; return lhs; }
+    friend constexpr fixed_big_int operator<<(fixed_big_int lhs, size_t shift) noexcept { lhs <<= shift; return lhs; }
+    friend constexpr fixed_big_int operator>>(fixed_big_int lhs, size_t shift) noexcept { lhs >>= shift; return lhs; }
+
+    friend constexpr bool operator==(const fixed_big_int &lhs, const fixed_big_int &rhs) noexcept = default;
+
+    friend constexpr std::strong_ordering operator<=>(const fixed_big_int &lhs, const fixed_big_int &rhs) noexcept
+    {
+        if (lhs.is_negative() != rhs.is_negative())
+            return lhs.is_negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+
+        for (size_t i = limb_count; i-- > 0;)
+        {
+            if (lhs._limbs[i] != rhs._limbs[i])
+                return lhs._limbs[i] < rhs._limbs[i] ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+
+        return std::strong_ordering::equal;
+    }
+
+    friend std::ostream &operator<<(std::ostream &stream, const fixed_big_int &value)
+    {
+        return stream << static_cast<big_int>(value);
+    }
+};
+
+namespace __detail
+{
+    constexpr size_t fixed_bits_for(size_t bits) noexcept
+    {
+        return bits == 0 ? limb_bits : (bits + limb_bits - 1) / limb_bits * limb_bits;
+    }
+
+    /** Integer literal with optional 0x, 0b or 0 prefix and digit separators, parsed at compile time
+     */
+    template<char... Chars>
+    struct fixed_literal
+    {
+        static constexpr char text[] = {Chars...};
+        static constexpr size_t length = sizeof...(Chars);
+
+        static constexpr unsigned int radix = length > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X') ? 16
+                                            : length > 2 && text[0] == '0' && (text[1] == 'b' || text[1] == 'B') ? 2
+                                            : length > 1 && text[0] == '0' ? 8 : 10;
+
+        static constexpr size_t prefix = radix == 16 || radix == 2 ? 2 : radix == 8 ? 1 : 0;
+
+        static constexpr auto digits = []
+        {
+            std::pair<std::array<char, length>, size_t> res{};
+
+            for (size_t i = prefix; i < length; ++i)
+            {
+                if (text[i] != '\'')
+                    res.first[res.second++] = text[i];
+            }
+
+            return res;
+        }();
+
+        // radix 10 is bounded by 4 bits a digit, one more bit keeps the value non-negative
+        static constexpr size_t bound = digits.second * (radix == 2 ? 1 : radix == 8 ? 3 : 4) + 1;
+
+        static constexpr fixed_big_int<fixed_bits_for(bound)> wide{std::string_view(digits.first.data(), digits.second), radix};
+
+        static constexpr size_t bits = fixed_bits_for(wide.bit_length() + 1);
+    };
+}
+
+/** fixed_big_int literal of the narrowest width in limbs that holds the value, evaluated at compile time.
+ *  _bi keeps its big_int meaning: a literal template cannot share suffix with operator""_bi(unsigned long long)
+ */
+template<char... Chars>
+consteval auto operator""_fbi()
+{
+    using literal = __detail::fixed_literal<Chars...>;
+    return fixed_big_int<literal::bits>(literal::wide);
+}
+
+#endif //MP_OS_FIXED_BIG_INT_H
@@ -0,0 +1,112 @@
+#ifndef MP_OS_RNS_INT_H
+#define MP_OS_RNS_INT_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <big_int.h>
+
+/** Basis of residue number system: primes below 2^62 whose product exceeds 2^(bits + 1), so every value
+ *  in (-2^bits, 2^bits) has its own residues. Montgomery constants of primes and Garner's coefficients for
+ *  reconstruction are prepared once and shared by all rns_int built on the basis
+ */
+class rns_basis final
+{
+public:
+
+    using value_type = big_int::value_type;
+
+private:
+
+    // one entry per prime, kept in separate arrays so loops over residues read them contiguously
+    std::vector<value_type> _primes;
+    std::vector<value_type> _inverses; // -prime^-1 mod 2^64
+    std::vector<value_type> _r2; // 2^128 mod prime
+    std::vector<value_type> _garner; // row j: Montgomery forms of p_i mod p_j for i < j, then (p_0 ... p_{j-1})^-1
+    big_int _product;
+    big_int _half_product;
+
+    friend class rns_int;
+
+public:
+
+    /** @throws std::invalid_argument if bits is zero
+     */
+    explicit rns_basis(size_t bits);
+
+    size_t size() const noexcept;
+
+    value_type prime(size_t index) const noexcept;
+
+    const big_int &product() const noexcept;
+};
+
+/** Integer as residues modulo primes of rns_basis. Addition, subtraction and multiplication act on every residue
+ *  independently with no carries between words, long bases split residues over threads of big_int pool. Conversion back is Garner's CRT in time quadratic in basis size,
+ *  so long chains of operations should convert once at the end. Only the final value has to lie in (-2^bits, 2^bits),
+ *  intermediate ones may leave it
+ */
+class rns_int final
+{
+public:
+
+    using value_type = rns_basis::value_type;
+
+private:
+
+    std::shared_ptr<const rns_basis> _basis;
+    std::vector<value_type> _residues; // Montgomery forms
+
+    void check_basis(const rns_int &other) const;
+
+    /** Runs body on ranges of residue indices. Residues are independent, so with big_int::parallelism > 1 ranges
+     *  go to shared pool once count * cost, cost being Montgomery multiplications per residue, reaches
+     *  8 * big_int::parallel_threshold, handing a range to pool costs about as much as 2000 multiplications
+     */
+    static void for_residues(size_t count, size_t cost, const std::function<void(size_t, size_t)> &body);
+
+public:
+
+    /** Zero on basis
+     */
+    explicit rns_int(std::shared_ptr<const rns_basis> basis);
+
+    rns_int(const big_int &value, std::shared_ptr<const rns_basis> basis);
+
+    const std::shared_ptr<const rns_basis> &basis() const noexcept;
+
+    /** Residue modulo basis->prime(index), in [0, prime)
+     */
+    value_type residue(size_t index) const noexcept;
+
+    /** Value in (-product / 2, product / 2] with given residues
+     */
+    big_int to_big_int() const;
+
+    explicit operator big_int() const;
+
+public:
+
+    /** Operands must share basis
+     *  @throws std::invalid_argument if bases differ
+     */
+    rns_int &operator+=(const rns_int &other) &;
+
+    rns_int operator+(const rns_int &other) const;
+
+    rns_int &operator-=(const rns_int &other) &;
+
+    rns_int operator-(const rns_int &other) const;
+
+    rns_int &operator*=(const rns_int &other) &;
+
+    rns_int operator*(const rns_int &other) const;
+
+    /** this += lhs * rhs in one pass over residues
+     */
+    rns_int &multiply_add(const rns_int &lhs, const rns_int &rhs) &;
+
+    bool operator==(const rns_int &other) const;
+};
+
+#endif //MP_OS_RNS_INT_H
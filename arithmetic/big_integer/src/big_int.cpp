@@ -5,214 +5,5186 @@
 #include "../include/big_int.h"
 #include <ranges>
 #include <exception>
+#include <stdexcept>
 #include <string>
 #include <sstream>
 #include <cmath>
 #include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <iterator>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <fstream>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    using limb = big_int::value_type;
+    using limb_vector = __detail::small_vector<limb, 2, pp_allocator<limb>>;
+
+    constexpr size_t limb_bits = __detail::limb_bits;
+
+    /** Raw limb kernels. All of them work on little-endian spans and know nothing about signs
+     */
+
+    int limbs_compare(const limb *a, size_t an, const limb *b, size_t bn) noexcept
+    {
+        if (an != bn)
+            return an < bn ? -1 : 1;
+
+        for (size_t i = an; i-- > 0;)
+        {
+            if (a[i] != b[i])
+                return a[i] < b[i] ? -1 : 1;
+        }
+
+        return 0;
+    }
+
+    limb limbs_add_n(limb *r, const limb *a, const limb *b, size_t n) noexcept
+    {
+        limb carry = 0;
+
+        for (size_t i = 0; i < n; ++i)
+            r[i] = __detail::add_with_carry(a[i], b[i], carry);
+
+        return carry;
+    }
+
+    limb limbs_add_1(limb *r, const limb *a, size_t n, limb b) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            r[i] = a[i] + b;
+            b = r[i] < b;
+
+            if (b == 0)
+            {
+                if (r != a)
+                    std::copy(a + i + 1, a + n, r + i + 1);
+                return 0;
+            }
+        }
+
+        return b;
+    }
+
+    /** an >= bn
+     */
+    limb limbs_add(limb *r, const limb *a, size_t an, const limb *b, size_t bn) noexcept
+    {
+        limb carry = limbs_add_n(r, a, b, bn);
+        return limbs_add_1(r + bn, a + bn, an - bn, carry);
+    }
+
+    limb limbs_sub_n(limb *r, const limb *a, const limb *b, size_t n) noexcept
+    {
+        limb borrow = 0;
+
+        for (size_t i = 0; i < n; ++i)
+            r[i] = __detail::sub_with_borrow(a[i], b[i], borrow);
+
+        return borrow;
+    }
+
+    limb limbs_sub_1(limb *r, const limb *a, size_t n, limb b) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb ai = a[i];
+            r[i] = ai - b;
+            b = ai < b;
+
+            if (b == 0)
+            {
+                if (r != a)
+                    std::copy(a + i + 1, a + n, r + i + 1);
+                return 0;
+            }
+        }
+
+        return b;
+    }
+
+    /** an >= bn
+     */
+    limb limbs_sub(limb *r, const limb *a, size_t an, const limb *b, size_t bn) noexcept
+    {
+        limb borrow = limbs_sub_n(r, a, b, bn);
+        return limbs_sub_1(r + bn, a + bn, an - bn, borrow);
+    }
+
+    /** r = a * b, returns high limb
+     */
+    limb limbs_mul_1(limb *r, const limb *a, size_t n, limb b) noexcept
+    {
+        limb carry = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb hi;
+            limb lo = __detail::multiply_wide(a[i], b, hi);
+            lo += carry;
+            carry = hi + (lo < carry);
+            r[i] = lo;
+        }
+
+        return carry;
+    }
+
+    /** r += a * b, returns high limb
+     */
+    limb limbs_addmul_1(limb *r, const limb *a, size_t n, limb b) noexcept
+    {
+        limb carry = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb hi;
+            limb lo = __detail::multiply_wide(a[i], b, hi);
+            lo += carry;
+            hi += lo < carry;
+            lo += r[i];
+            hi += lo < r[i];
+            r[i] = lo;
+            carry = hi;
+        }
+
+        return carry;
+    }
+
+    /** r -= a * b, returns high limb that has to be subtracted from r[n]
+     */
+    limb limbs_submul_1(limb *r, const limb *a, size_t n, limb b) noexcept
+    {
+        limb carry = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb hi;
+            limb lo = __detail::multiply_wide(a[i], b, hi);
+            lo += carry;
+            hi += lo < carry;
+            limb ri = r[i];
+            r[i] = ri - lo;
+            carry = hi + (ri < lo);
+        }
+
+        return carry;
+    }
+
+    /** d^-1 mod B for odd d
+     */
+    limb limb_inverse_2adic(limb d) noexcept
+    {
+        limb inverse = d; // correct to 3 bits, every Newton step doubles that
+
+        for (int i = 0; i < 5; ++i)
+            inverse *= 2 - d * inverse;
+
+        return inverse;
+    }
+
+    /** r = a / d for odd d that divides a exactly, by multiplication with inverse of d modulo B. r may be equal to a
+     */
+    void limbs_divexact_1(limb *r, const limb *a, size_t n, limb d) noexcept
+    {
+        limb inverse = limb_inverse_2adic(d);
+        limb borrow = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb ai = a[i];
+            limb x = ai - borrow;
+            borrow = ai < borrow;
+
+            limb q = x * inverse;
+            r[i] = q;
+
+            limb hi;
+            __detail::multiply_wide(q, d, hi);
+            borrow += hi;
+        }
+    }
+
+    /** r[0, an + bn) = a * b, r must not overlap a or b
+     */
+    void limbs_mul_basecase(limb *r, const limb *a, size_t an, const limb *b, size_t bn) noexcept
+    {
+        if (an < bn)
+        {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+
+        if (bn == 0)
+        {
+            std::fill(r, r + an, 0);
+            return;
+        }
+
+        r[an] = limbs_mul_1(r, a, an, b[0]);
+
+        for (size_t i = 1; i < bn; ++i)
+            r[an + i] = limbs_addmul_1(r + i, a, an, b[i]);
+    }
+
+    /** 0 < count < 64, r may be equal to a, returns bits shifted out
+     */
+    limb limbs_lshift(limb *r, const limb *a, size_t n, unsigned count) noexcept
+    {
+        limb out = a[n - 1] >> (limb_bits - count);
+
+        for (size_t i = n - 1; i > 0; --i)
+            r[i] = (a[i] << count) | (a[i - 1] >> (limb_bits - count));
+
+        r[0] = a[0] << count;
+        return out;
+    }
+
+    /** 0 < count < 64, r may be equal to a, returns bits shifted out (in high bits of result)
+     */
+    limb limbs_rshift(limb *r, const limb *a, size_t n, unsigned count) noexcept
+    {
+        limb out = a[0] << (limb_bits - count);
+
+        for (size_t i = 0; i + 1 < n; ++i)
+            r[i] = (a[i] >> count) | (a[i + 1] << (limb_bits - count));
+
+        r[n - 1] = a[n - 1] >> count;
+        return out;
+    }
+
+    /** r[0, 2n) = a^2, every cross product is computed once
+     */
+    void limbs_sqr_basecase(limb *r, const limb *a, size_t n) noexcept
+    {
+        std::fill(r, r + 2 * n, 0);
+
+        for (size_t i = 0; i + 1 < n; ++i)
+            r[i + n] = limbs_addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+
+        r[2 * n - 1] = limbs_lshift(r, r, 2 * n - 1, 1);
+
+        limb carry = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb hi;
+            limb lo = __detail::multiply_wide(a[i], a[i], hi);
+            r[2 * i] = __detail::add_with_carry(r[2 * i], lo, carry);
+            r[2 * i + 1] = __detail::add_with_carry(r[2 * i + 1], hi, carry);
+        }
+    }
+
+    /** Compares spans that may have leading zero limbs
+     */
+    int limbs_compare_padded(const limb *a, size_t an, const limb *b, size_t bn) noexcept
+    {
+        while (an > 0 && a[an - 1] == 0)
+            --an;
+        while (bn > 0 && b[bn - 1] == 0)
+            --bn;
+        return limbs_compare(a, an, b, bn);
+    }
+
+    /** r[0, n) = |a - b| where b has bn <= n limbs, returns true if a < b
+     */
+    bool limbs_abs_sub(limb *r, const limb *a, size_t n, const limb *b, size_t bn) noexcept
+    {
+        if (limbs_compare_padded(a, n, b, bn) >= 0)
+        {
+            limbs_sub(r, a, n, b, bn);
+            return false;
+        }
+
+        limbs_sub_n(r, b, a, bn);
+        std::fill(r + bn, r + n, 0);
+        return true;
+    }
+
+    /** Fixed-size pool of workers shared by parallel multiplication. A thread waiting for its tasks runs
+     *  queued ones meanwhile, so nested parallel sections cannot deadlock
+     */
+    class thread_pool final
+    {
+        std::vector<std::thread> _workers;
+        std::deque<std::function<void()>> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _stop = false;
+
+    public:
+
+        explicit thread_pool(size_t workers)
+        {
+            for (size_t i = 0; i < workers; ++i)
+                _workers.emplace_back([this] { worker_loop(); });
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard lock(_mutex);
+                _stop = true;
+            }
+            _condition.notify_all();
+
+            for (auto &worker : _workers)
+                worker.join();
+        }
+
+        void submit(std::function<void()> task)
+        {
+            {
+                std::lock_guard lock(_mutex);
+                _tasks.push_back(std::move(task));
+            }
+            _condition.notify_one();
+        }
+
+        /** Runs one queued task on the calling thread, returns false if there was none
+         */
+        bool run_pending()
+        {
+            std::function<void()> task;
+            {
+                std::lock_guard lock(_mutex);
+                if (_tasks.empty())
+                    return false;
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+            return true;
+        }
+
+    private:
+
+        void worker_loop()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock(_mutex);
+                    _condition.wait(lock, [this] { return _stop || !_tasks.empty(); });
+                    if (_tasks.empty())
+                        return;
+                    task = std::move(_tasks.front());
+                    _tasks.pop_front();
+                }
+                task();
+            }
+        }
+    };
+
+    std::mutex thread_pool_mutex;
+    std::shared_ptr<thread_pool> thread_pool_instance;
+    size_t thread_pool_size = 0;
+
+    std::shared_ptr<thread_pool> shared_thread_pool()
+    {
+        std::lock_guard lock(thread_pool_mutex);
+
+        if (!thread_pool_instance)
+        {
+            size_t threads = thread_pool_size != 0 ? thread_pool_size : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            thread_pool_instance = std::make_shared<thread_pool>(threads - 1);
+        }
+
+        return thread_pool_instance;
+    }
+
+    /** Tasks forked by one parallel section, wait() joins them and rethrows the first exception
+     */
+    class task_group final
+    {
+        std::shared_ptr<thread_pool> _pool;
+        std::atomic<size_t> _pending = 0;
+        std::mutex _error_mutex;
+        std::exception_ptr _error;
+
+    public:
+
+        task_group() : _pool(shared_thread_pool()) {}
+
+        task_group(const task_group &) = delete;
+        task_group &operator=(const task_group &) = delete;
+
+        ~task_group()
+        {
+            while (_pending.load() != 0)
+            {
+                if (!_pool->run_pending())
+                    std::this_thread::yield();
+            }
+        }
+
+        void run(std::function<void()> task)
+        {
+            ++_pending;
+            _pool->submit([this, task = std::move(task)]
+            {
+                try
+                {
+                    task();
+                } catch (...)
+                {
+                    std::lock_guard lock(_error_mutex);
+                    if (!_error)
+                        _error = std::current_exception();
+                }
+                --_pending;
+            });
+        }
+
+        void wait()
+        {
+            while (_pending.load() != 0)
+            {
+                if (!_pool->run_pending())
+                    std::this_thread::yield();
+            }
+
+            if (_error)
+                std::rethrow_exception(_error);
+        }
+    };
+
+    /** Splits [begin, end) into chunks processed in parallel, the calling thread takes the first one
+     */
+    template<class F>
+    void parallel_for(size_t begin, size_t end, size_t chunks, F &&body)
+    {
+        if (chunks <= 1 || end - begin < 2 * chunks)
+        {
+            body(begin, end);
+            return;
+        }
+
+        size_t step = (end - begin + chunks - 1) / chunks;
+        task_group group;
+
+        for (size_t lo = begin + step; lo < end; lo += step)
+            group.run([&body, lo, hi = std::min(lo + step, end)] { body(lo, hi); });
+
+        body(begin, begin + step);
+        group.wait();
+    }
+
+    /** Number of recursion levels to fork so that about threads tasks run at once with given branching
+     */
+    size_t parallel_depth(size_t threads, size_t branching) noexcept
+    {
+        size_t depth = 0;
+
+        for (size_t tasks = 1; tasks < threads; tasks *= branching)
+            ++depth;
+
+        return depth;
+    }
+
+    size_t karatsuba_cutoff() noexcept
+    {
+        return std::max<size_t>(big_int::karatsuba_threshold, 8);
+    }
+
+    size_t karatsuba_square_cutoff() noexcept
+    {
+        return std::max<size_t>(big_int::karatsuba_square_threshold, 8);
+    }
+
+    /** Scratch limbs enough for Karatsuba product or square of operands not longer than n
+     */
+    size_t karatsuba_scratch_size(size_t n) noexcept
+    {
+        if (n < std::min(karatsuba_cutoff(), karatsuba_square_cutoff()))
+            return 0;
+
+        size_t m = (n + 1) / 2;
+        return 4 * m + std::max(karatsuba_scratch_size(m), 2 * m + 1);
+    }
+
+    void limbs_mul_karatsuba(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws) noexcept;
+
+    void limbs_sqr_karatsuba(limb *r, const limb *a, size_t n, limb *ws) noexcept;
+
+    /** r[0, an + bn) = a * b with Karatsuba above cutoff, ws holds karatsuba_scratch_size(max(an, bn)) limbs
+     */
+    void limbs_mul_recursive(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws) noexcept
+    {
+        if (an < bn)
+        {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+
+        if (bn < karatsuba_cutoff())
+            limbs_mul_basecase(r, a, an, b, bn);
+        else
+            limbs_mul_karatsuba(r, a, an, b, bn, ws);
+    }
+
+    void limbs_sqr_recursive(limb *r, const limb *a, size_t n, limb *ws) noexcept
+    {
+        if (n < karatsuba_square_cutoff())
+            limbs_sqr_basecase(r, a, n);
+        else
+            limbs_sqr_karatsuba(r, a, n, ws);
+    }
+
+    /** Adds middle coefficient t = z0 + z2 -+ z1 of Karatsuba into r at offset m
+     */
+    void karatsuba_interpolate(limb *r, size_t rn, size_t m, size_t z2n, const limb *z1, bool z1_negative, limb *t) noexcept
+    {
+        std::copy(r, r + 2 * m, t);
+        t[2 * m] = 0;
+        limbs_add(t, t, 2 * m + 1, r + 2 * m, z2n);
+
+        if (z1_negative)
+            limbs_add(t, t, 2 * m + 1, z1, 2 * m);
+        else
+            limbs_sub(t, t, 2 * m + 1, z1, 2 * m);
+
+        size_t tn = 2 * m + 1;
+        while (tn > 0 && t[tn - 1] == 0)
+            --tn;
+
+        limbs_add(r + m, r + m, rn - m, t, tn);
+    }
+
+    /** an >= bn >= karatsuba_cutoff()
+     */
+    void limbs_mul_karatsuba(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws) noexcept
+    {
+        size_t m = (an + 1) / 2;
+
+        if (bn <= m)
+        {
+            // operands are too unbalanced to split at the same point, multiply by blocks of bn limbs
+            limb *tmp = ws;
+            ws += 2 * bn;
+
+            limbs_mul_recursive(r, a, bn, b, bn, ws);
+            std::fill(r + 2 * bn, r + an + bn, 0);
+
+            for (size_t i = bn; i < an; i += bn)
+            {
+                size_t len = std::min(bn, an - i);
+                limbs_mul_recursive(tmp, b, bn, a + i, len, ws);
+                limbs_add(r + i, r + i, an + bn - i, tmp, bn + len);
+            }
+
+            return;
+        }
+
+        size_t a1n = an - m, b1n = bn - m;
+
+        limb *da = ws, *db = ws + m, *z1 = ws + 2 * m, *rest = ws + 4 * m;
+
+        bool z1_negative = limbs_abs_sub(da, a, m, a + m, a1n) != limbs_abs_sub(db, b, m, b + m, b1n);
+
+        limbs_mul_recursive(z1, da, m, db, m, rest);
+        limbs_mul_recursive(r, a, m, b, m, rest);
+        limbs_mul_recursive(r + 2 * m, a + m, a1n, b + m, b1n, rest);
+
+        karatsuba_interpolate(r, an + bn, m, a1n + b1n, z1, z1_negative, rest);
+    }
+
+    /** n >= karatsuba_square_cutoff()
+     */
+    void limbs_sqr_karatsuba(limb *r, const limb *a, size_t n, limb *ws) noexcept
+    {
+        size_t m = (n + 1) / 2, a1n = n - m;
+
+        limb *da = ws, *z1 = ws + m, *rest = ws + 3 * m;
+
+        limbs_abs_sub(da, a, m, a + m, a1n);
+
+        limbs_sqr_recursive(z1, da, m, rest);
+        limbs_sqr_recursive(r, a, m, rest);
+        limbs_sqr_recursive(r + 2 * m, a + m, a1n, rest);
+
+        karatsuba_interpolate(r, 2 * n, m, 2 * a1n, z1, false, rest);
+    }
+
+    size_t parallel_cutoff() noexcept
+    {
+        return std::max({big_int::parallel_threshold, karatsuba_cutoff(), karatsuba_square_cutoff()});
+    }
+
+    /** Scratch for the parallel Karatsuba, every forked level needs separate areas for its three subproducts
+     */
+    size_t karatsuba_parallel_scratch_size(size_t n, size_t depth) noexcept
+    {
+        if (depth == 0 || n < parallel_cutoff())
+            return karatsuba_scratch_size(n);
+
+        size_t m = (n + 1) / 2;
+        return 4 * m + std::max(3 * karatsuba_parallel_scratch_size(m, depth - 1), 2 * m + 1);
+    }
+
+    /** Karatsuba that forks its three subproducts for depth levels, ws holds karatsuba_parallel_scratch_size(max(an, bn), depth) limbs
+     */
+    void limbs_mul_parallel(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws, size_t depth)
+    {
+        if (an < bn)
+        {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+
+        size_t m = (an + 1) / 2;
+
+        if (depth == 0 || bn < parallel_cutoff() || bn <= m)
+        {
+            limbs_mul_recursive(r, a, an, b, bn, ws);
+            return;
+        }
+
+        size_t a1n = an - m, b1n = bn - m;
+        size_t sub = karatsuba_parallel_scratch_size(m, depth - 1);
+
+        limb *da = ws, *db = ws + m, *z1 = ws + 2 * m, *rest = ws + 4 * m;
+
+        bool z1_negative = limbs_abs_sub(da, a, m, a + m, a1n) != limbs_abs_sub(db, b, m, b + m, b1n);
+
+        {
+            task_group group;
+            group.run([=] { limbs_mul_parallel(z1, da, m, db, m, rest, depth - 1); });
+            group.run([=] { limbs_mul_parallel(r + 2 * m, a + m, a1n, b + m, b1n, rest + sub, depth - 1); });
+            limbs_mul_parallel(r, a, m, b, m, rest + 2 * sub, depth - 1);
+            group.wait();
+        }
+
+        karatsuba_interpolate(r, an + bn, m, a1n + b1n, z1, z1_negative, rest);
+    }
+
+    void limbs_sqr_parallel(limb *r, const limb *a, size_t n, limb *ws, size_t depth)
+    {
+        if (depth == 0 || n < parallel_cutoff())
+        {
+            limbs_sqr_recursive(r, a, n, ws);
+            return;
+        }
+
+        size_t m = (n + 1) / 2, a1n = n - m;
+        size_t sub = karatsuba_parallel_scratch_size(m, depth - 1);
+
+        limb *da = ws, *z1 = ws + m, *rest = ws + 3 * m;
+
+        limbs_abs_sub(da, a, m, a + m, a1n);
+
+        {
+            task_group group;
+            group.run([=] { limbs_sqr_parallel(z1, da, m, rest, depth - 1); });
+            group.run([=] { limbs_sqr_parallel(r + 2 * m, a + m, a1n, rest + sub, depth - 1); });
+            limbs_sqr_parallel(r, a, m, rest + 2 * sub, depth - 1);
+            group.wait();
+        }
+
+        karatsuba_interpolate(r, 2 * n, m, 2 * a1n, z1, false, rest);
+    }
+
+    size_t toom3_cutoff() noexcept
+    {
+        return std::max<size_t>(big_int::toom3_threshold, 18);
+    }
+
+    size_t toom4_cutoff() noexcept
+    {
+        return std::max<size_t>(big_int::toom4_threshold, 24);
+    }
+
+    bool toom_forks(size_t n, size_t depth) noexcept
+    {
+        return depth > 0 && n >= parallel_cutoff();
+    }
+
+    /** Scratch for limbs_mul_toom with operands not longer than n. Covers every split the dispatcher may choose:
+     *  evaluations and pointwise products of a Toom step take at most 21 * (ceil(n / 3) + 1) limbs, forked products
+     *  need separate areas, unbalanced operands are sliced with 2 * bn <= n limbs for partial product
+     */
+    size_t toom_scratch_size(size_t n, size_t depth) noexcept
+    {
+        size_t karatsuba = karatsuba_parallel_scratch_size(n, depth);
+
+        if (n < toom3_cutoff())
+            return karatsuba;
+
+        size_t m = (n + 2) / 3;
+        bool forks = toom_forks(n, depth);
+        size_t points = toom_scratch_size(m + 1, forks ? depth - 1 : depth) * (forks ? 7 : 1);
+
+        return std::max({karatsuba, 21 * (m + 1) + points, n + toom_scratch_size(n / 2, depth)});
+    }
+
+    /** Evaluates polynomial with k coefficients (pieces of m limbs, the last one of s limbs) at 2^shift and -2^shift.
+     *  plus and minus get m + 1 limbs, minus holds magnitude, returns true if value at -2^shift is negative.
+     *  tmp holds m + 1 limbs
+     */
+    bool toom_eval_pm(limb *plus, limb *minus, const limb *a, size_t k, size_t m, size_t s, unsigned shift, limb *tmp) noexcept
+    {
+        size_t e = m + 1;
+
+        std::fill(plus, plus + e, 0);
+        std::fill(tmp, tmp + e, 0);
+
+        for (size_t i = 0; i < k; ++i)
+        {
+            size_t len = i + 1 == k ? s : m;
+            limb *sum = i % 2 == 0 ? plus : tmp; // even part into plus, odd into tmp
+
+            if (shift * i == 0)
+            {
+                limbs_add(sum, sum, e, a + i * m, len);
+            } else
+            {
+                minus[len] = limbs_lshift(minus, a + i * m, len, static_cast<unsigned>(shift * i));
+                limbs_add(sum, sum, e, minus, len + 1);
+            }
+        }
+
+        bool negative = limbs_abs_sub(minus, plus, e, tmp, e);
+        limbs_add_n(plus, plus, tmp, e);
+        return negative;
+    }
+
+    /** r[0, m + 1) = sum of a_i * 2^(i * shift), or with weights 2^((k - 1 - i) * shift) if reversed
+     */
+    void toom_eval_pow2(limb *r, const limb *a, size_t k, size_t m, size_t s, unsigned shift, bool reversed) noexcept
+    {
+        size_t e = m + 1;
+
+        std::fill(r, r + e, 0);
+
+        for (size_t j = 0; j < k; ++j)
+        {
+            size_t i = reversed ? j : k - 1 - j; // Horner from the heaviest weight
+
+            if (j > 0)
+                limbs_lshift(r, r, e, shift);
+
+            limbs_add(r, r, e, a + i * m, i + 1 == k ? s : m);
+        }
+    }
+
+    /** plus = W(p), minus = |W(-p)| with sign negative, p = 2^(odd_shift - 1).
+     *  Replaces them with even part (W(p) + W(-p)) / 2 and odd part (W(p) - W(-p)) / (2p)
+     */
+    void toom_even_odd(limb *plus, limb *minus, bool negative, size_t w, unsigned odd_shift) noexcept
+    {
+        limb carry = 0, borrow = 0;
+
+        for (size_t i = 0; i < w; ++i)
+        {
+            limb p = plus[i], q = minus[i];
+            plus[i] = __detail::add_with_carry(p, q, carry);
+            minus[i] = __detail::sub_with_borrow(p, q, borrow);
+        }
+
+        if (negative)
+            std::swap(plus, minus);
+
+        limbs_rshift(plus, plus, w, 1);
+        limbs_rshift(minus, minus, w, odd_shift);
+
+        if (negative)
+            std::swap_ranges(plus, plus + w, minus);
+    }
+
+    /** r[0, w) -= a[0, an) << shift for an < w, tmp holds an + 1 limbs
+     */
+    void toom_sub_shifted(limb *r, size_t w, const limb *a, size_t an, unsigned shift, limb *tmp) noexcept
+    {
+        tmp[an] = limbs_lshift(tmp, a, an, shift);
+        limbs_sub(r, r, w, tmp, an + 1);
+    }
+
+    /** r[offset, rn) += c[0, n), leading zero limbs of c are skipped
+     */
+    void toom_add_at(limb *r, size_t rn, size_t offset, const limb *c, size_t n) noexcept
+    {
+        while (n > 0 && c[n - 1] == 0)
+            --n;
+
+        if (n > 0)
+            limbs_add(r + offset, r + offset, rn - offset, c, n);
+    }
+
+    struct toom_product
+    {
+        limb *r;
+        const limb *a;
+        size_t an;
+        const limb *b;
+        size_t bn;
+    };
+
+    void limbs_mul_toom(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws, size_t depth, bool toom4);
+
+    /** Pointwise products of a Toom step. When forked each product gets sub limbs of ws
+     */
+    void toom_pointwise(const toom_product *products, size_t count, limb *ws, size_t n, size_t depth, bool toom4)
+    {
+        if (!toom_forks(n, depth))
+        {
+            for (size_t i = 0; i < count; ++i)
+                limbs_mul_toom(products[i].r, products[i].a, products[i].an, products[i].b, products[i].bn, ws, depth, toom4);
+            return;
+        }
+
+        size_t sub = toom_scratch_size((n + 2) / 3 + 1, depth - 1);
+        task_group group;
+
+        for (size_t i = 1; i < count; ++i)
+            group.run([=, p = products[i]] { limbs_mul_toom(p.r, p.a, p.an, p.b, p.bn, ws + i * sub, depth - 1, toom4); });
+
+        limbs_mul_toom(products[0].r, products[0].a, products[0].an, products[0].b, products[0].bn, ws, depth - 1, toom4);
+        group.wait();
+    }
+
+    /** Toom-3.2: a in three pieces of m limbs, b in two, points 0, 1, -1, inf. an >= bn, m < bn <= 2m
+     */
+    void limbs_mul_toom32(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws, size_t depth, bool toom4)
+    {
+        size_t m = (an + 2) / 3, s = an - 2 * m, t = bn - m, e = m + 1, w = 2 * m + 2, rn = an + bn;
+
+        limb *ap1 = ws, *am1 = ap1 + e, *bp1 = am1 + e, *bm1 = bp1 + e, *tmp = bm1 + e;
+        limb *w1 = tmp + e, *wm1 = w1 + w, *winf = wm1 + w, *rest = winf + w;
+
+        bool negative = toom_eval_pm(ap1, am1, a, 3, m, s, 0, tmp) != toom_eval_pm(bp1, bm1, b, 2, m, t, 0, tmp);
+
+        const toom_product products[] = {{w1, ap1, e, bp1, e}, {wm1, am1, e, bm1, e}, {r, a, m, b, m}, {winf, a + 2 * m, s, b + m, t}};
+        toom_pointwise(products, 4, rest, an, depth, toom4);
+
+        // c0 = W0, c3 = Winf, c2 = (W1 + W-1) / 2 - c0, c1 = (W1 - W-1) / 2 - c3
+        toom_even_odd(w1, wm1, negative, w, 1);
+        limbs_sub(w1, w1, w, r, 2 * m);
+        limbs_sub(wm1, wm1, w, winf, s + t);
+
+        std::fill(r + 2 * m, r + rn, 0);
+        toom_add_at(r, rn, m, wm1, w);
+        toom_add_at(r, rn, 2 * m, w1, w);
+        toom_add_at(r, rn, 3 * m, winf, s + t);
+    }
+
+    /** Toom-3: pieces of m limbs, points 0, 1, -1, 2, inf. an >= bn > 2m
+     */
+    void limbs_mul_toom33(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws, size_t depth, bool toom4)
+    {
+        bool square = a == b && an == bn;
+        size_t m = (an + 2) / 3, s = an - 2 * m, t = bn - 2 * m, e = m + 1, w = 2 * m + 2, rn = an + bn;
+
+        limb *ap1 = ws, *am1 = ap1 + e, *ap2 = am1 + e, *bp1 = ap2 + e, *bm1 = bp1 + e, *bp2 = bm1 + e, *tmp = bp2 + e;
+        limb *w1 = tmp + e, *wm1 = w1 + w, *w2 = wm1 + w, *rest = w2 + w;
+        limb *c0 = r, *c4 = r + 4 * m;
+
+        bool negative = toom_eval_pm(ap1, am1, a, 3, m, s, 0, tmp);
+        toom_eval_pow2(ap2, a, 3, m, s, 1, false);
+
+        if (square)
+        {
+            bp1 = ap1, bm1 = am1, bp2 = ap2;
+            negative = false;
+        } else
+        {
+            negative = negative != toom_eval_pm(bp1, bm1, b, 3, m, t, 0, tmp);
+            toom_eval_pow2(bp2, b, 3, m, t, 1, false);
+        }
+
+        // W0 and Winf go straight to their places in r
+        const toom_product products[] = {{w1, ap1, e, bp1, e}, {wm1, am1, e, bm1, e}, {w2, ap2, e, bp2, e},
+                                         {c0, a, m, b, m}, {c4, a + 2 * m, s, b + 2 * m, t}};
+        toom_pointwise(products, 5, rest, an, depth, toom4);
+
+        // every coefficient is nonnegative, only W-1 is signed:
+        // c2 = (W1 + W-1) / 2 - c0 - c4, c3 = ((W2 - c0 - 4c2 - 16c4) / 2 - (W1 - W-1) / 2) / 3, c1 = (W1 - W-1) / 2 - c3
+        limb *t1 = ws;
+
+        toom_even_odd(w1, wm1, negative, w, 1);
+        limbs_sub(w1, w1, w, c0, 2 * m);
+        limbs_sub(w1, w1, w, c4, s + t);
+
+        limbs_sub(w2, w2, w, c0, 2 * m);
+        toom_sub_shifted(w2, w, w1, w - 1, 2, t1);
+        toom_sub_shifted(w2, w, c4, s + t, 4, t1);
+        limbs_rshift(w2, w2, w, 1);
+        limbs_sub_n(w2, w2, wm1, w);
+        limbs_divexact_1(w2, w2, w, 3);
+
+        limbs_sub_n(wm1, wm1, w2, w);
+
+        std::copy(w1, w1 + 2 * m, r + 2 * m);
+        toom_add_at(r, rn, 4 * m, w1 + 2 * m, w - 2 * m);
+        toom_add_at(r, rn, m, wm1, w);
+        toom_add_at(r, rn, 3 * m, w2, w);
+    }
+
+    /** Toom-4: pieces of m limbs, points 0, 1, -1, 2, -2, 1/2, inf. an >= bn > 3m
+     */
+    void limbs_mul_toom44(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws, size_t depth)
+    {
+        bool square = a == b && an == bn;
+        size_t m = (an + 3) / 4, s = an - 3 * m, t = bn - 3 * m, e = m + 1, w = 2 * m + 2, rn = an + bn;
+
+        limb *ap1 = ws, *am1 = ap1 + e, *ap2 = am1 + e, *am2 = ap2 + e, *ah = am2 + e;
+        limb *bp1 = ah + e, *bm1 = bp1 + e, *bp2 = bm1 + e, *bm2 = bp2 + e, *bh = bm2 + e, *tmp = bh + e;
+        limb *w1 = tmp + e, *wm1 = w1 + w, *w2 = wm1 + w, *wm2 = w2 + w, *wh = wm2 + w, *rest = wh + w;
+        limb *c0 = r, *c6 = r + 6 * m;
+
+        bool negative1 = toom_eval_pm(ap1, am1, a, 4, m, s, 0, tmp);
+        bool negative2 = toom_eval_pm(ap2, am2, a, 4, m, s, 1, tmp);
+        toom_eval_pow2(ah, a, 4, m, s, 1, true);
+
+        if (square)
+        {
+            bp1 = ap1, bm1 = am1, bp2 = ap2, bm2 = am2, bh = ah;
+            negative1 = negative2 = false;
+        } else
+        {
+            negative1 = negative1 != toom_eval_pm(bp1, bm1, b, 4, m, t, 0, tmp);
+            negative2 = negative2 != toom_eval_pm(bp2, bm2, b, 4, m, t, 1, tmp);
+            toom_eval_pow2(bh, b, 4, m, t, 1, true);
+        }
+
+        const toom_product products[] = {{w1, ap1, e, bp1, e}, {wm1, am1, e, bm1, e}, {w2, ap2, e, bp2, e}, {wm2, am2, e, bm2, e},
+                                         {wh, ah, e, bh, e}, {c0, a, m, b, m}, {c6, a + 3 * m, s, b + 3 * m, t}};
+        toom_pointwise(products, 7, rest, an, depth, true);
+
+        // Wh = 64 C(1/2). Even and odd parts at 1 and 2 give c2, c4 and two equations for c1, c3, c5, third comes from Wh:
+        // P = E1 - c0 - c6 = c2 + c4, Q = (E2 - c0 - 64c6) / 4 = c2 + 4c4, so c4 = (Q - P) / 3, c2 = P - c4.
+        // R = (Wh - 64c0 - 16c2 - 4c4 - c6) / 2 = 16c1 + 4c3 + c5, S = (O2 - O1) / 3 = c3 + 5c5, T = (16 O1 - R) / 3 = 4c3 + 5c5,
+        // so c3 = (T - S) / 3, c5 = (S - c3) / 5, c1 = O1 - c3 - c5
+        limb *t1 = ws;
+
+        toom_even_odd(w1, wm1, negative1, w, 1);
+        toom_even_odd(w2, wm2, negative2, w, 2);
+
+        limbs_sub(w1, w1, w, c0, 2 * m);
+        limbs_sub(w1, w1, w, c6, s + t);
+
+        limbs_sub(w2, w2, w, c0, 2 * m);
+        toom_sub_shifted(w2, w, c6, s + t, 6, t1);
+        limbs_rshift(w2, w2, w, 2);
+        limbs_sub_n(w2, w2, w1, w);
+        limbs_divexact_1(w2, w2, w, 3);
+        limbs_sub_n(w1, w1, w2, w);
+
+        toom_sub_shifted(wh, w, c0, 2 * m, 6, t1);
+        toom_sub_shifted(wh, w, w1, w - 1, 4, t1);
+        toom_sub_shifted(wh, w, w2, w - 1, 2, t1);
+        limbs_sub(wh, wh, w, c6, s + t);
+        limbs_rshift(wh, wh, w, 1);
+
+        limbs_sub_n(wm2, wm2, wm1, w);
+        limbs_divexact_1(wm2, wm2, w, 3);
+
+        limbs_lshift(t1, wm1, w, 4);
+        limbs_sub_n(wh, t1, wh, w);
+        limbs_divexact_1(wh, wh, w, 3);
+
+        limbs_sub_n(wh, wh, wm2, w);
+        limbs_divexact_1(wh, wh, w, 3);
+
+        limbs_sub_n(wm2, wm2, wh, w);
+        limbs_divexact_1(wm2, wm2, w, 5);
+
+        limbs_sub_n(wm1, wm1, wh, w);
+        limbs_sub_n(wm1, wm1, wm2, w);
+
+        std::copy(w1, w1 + 2 * m, r + 2 * m);
+        std::copy(w2, w2 + 2 * m, r + 4 * m);
+        toom_add_at(r, rn, 4 * m, w1 + 2 * m, w - 2 * m);
+        toom_add_at(r, rn, 6 * m, w2 + 2 * m, w - 2 * m);
+        toom_add_at(r, rn, m, wm1, w);
+        toom_add_at(r, rn, 3 * m, wh, w);
+        toom_add_at(r, rn, 5 * m, wm2, w);
+    }
+
+    /** r[0, an + bn) = a * b choosing Toom-4 (if allowed), Toom-3 or Toom-3.2 by sizes of operands, parallel Karatsuba
+     *  below Toom-3 cutoff. Operands more unbalanced than 2:1 are multiplied by blocks of bn limbs.
+     *  Toom steps fork their pointwise products for depth levels, ws holds toom_scratch_size(max(an, bn), depth) limbs
+     */
+    void limbs_mul_toom(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws, size_t depth, bool toom4)
+    {
+        if (an < bn)
+        {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+
+        bool square = a == b && an == bn;
+
+        if (bn < toom3_cutoff())
+        {
+            if (square)
+                limbs_sqr_parallel(r, a, an, ws, depth);
+            else
+                limbs_mul_parallel(r, a, an, b, bn, ws, depth);
+            return;
+        }
+
+        if (toom4 && bn >= toom4_cutoff() && bn > 3 * ((an + 3) / 4))
+        {
+            limbs_mul_toom44(r, a, an, b, bn, ws, depth);
+        } else if (bn > 2 * ((an + 2) / 3))
+        {
+            limbs_mul_toom33(r, a, an, b, bn, ws, depth, toom4);
+        } else if (2 * bn >= an)
+        {
+            limbs_mul_toom32(r, a, an, b, bn, ws, depth, toom4);
+        } else
+        {
+            limb *tmp = ws;
+            ws += 2 * bn;
+
+            limbs_mul_toom(r, a, bn, b, bn, ws, depth, toom4);
+            std::fill(r + 2 * bn, r + an + bn, 0);
+
+            for (size_t i = bn; i < an; i += bn)
+            {
+                size_t len = std::min(bn, an - i);
+                limbs_mul_toom(tmp, b, bn, a + i, len, ws, depth, toom4);
+                limbs_add(r + i, r + i, an + bn - i, tmp, bn + len);
+            }
+        }
+    }
+
+    /** Word-sized NTT prime with Montgomery arithmetic, R = 2^64. Requires p < 2^63
+     */
+    struct ntt_prime
+    {
+        limb p, p_inv, r2, generator;
+
+        constexpr ntt_prime(limb modulus, limb primitive_root) noexcept : p(modulus), p_inv(modulus), r2(1), generator(primitive_root)
+        {
+            for (int i = 0; i < 6; ++i)
+                p_inv *= 2 - p * p_inv;
+
+            for (int i = 0; i < 128; ++i)
+                r2 = add(r2, r2);
+        }
+
+        constexpr limb add(limb a, limb b) const noexcept
+        {
+            limb res = a + b;
+            return res >= p ? res - p : res;
+        }
+
+        constexpr limb sub(limb a, limb b) const noexcept
+        {
+            return a >= b ? a - b : a + p - b;
+        }
+
+        /** (hi * 2^64 + lo) / R mod p, requires hi < p
+         */
+        constexpr limb reduce(limb hi, limb lo) const noexcept
+        {
+            limb m_hi;
+            __detail::multiply_wide(lo * p_inv, p, m_hi);
+            return hi >= m_hi ? hi - m_hi : hi - m_hi + p;
+        }
+
+        constexpr limb mul(limb a, limb b) const noexcept
+        {
+            limb hi;
+            limb lo = __detail::multiply_wide(a, b, hi);
+            return reduce(hi, lo);
+        }
+
+        /** Any limb to Montgomery form
+         */
+        constexpr limb to_montgomery(limb a) const noexcept
+        {
+            return mul(a, r2);
+        }
+
+        constexpr limb one() const noexcept
+        {
+            return to_montgomery(1);
+        }
+
+        constexpr limb pow(limb base, limb exponent) const noexcept
+        {
+            limb res = one();
+
+            while (exponent != 0)
+            {
+                if (exponent & 1)
+                    res = mul(res, base);
+                base = mul(base, base);
+                exponent >>= 1;
+            }
+
+            return res;
+        }
+
+        /** Plain residue of a^-1, a is plain
+         */
+        constexpr limb inverse(limb a) const noexcept
+        {
+            return reduce(0, pow(to_montgomery(a), p - 2));
+        }
+    };
+
+    constexpr ntt_prime ntt_primes[3] =
+    {
+        ntt_prime(0x3fdc000000000001ull, 3),
+        ntt_prime(0x3f18000000000001ull, 10),
+        ntt_prime(0x3ec4000000000001ull, 37)
+    };
+
+    /** Sub-transforms not longer than this run level by level, longer ones are split depth-first so that
+     *  every butterfly pass below works on a block that stays in cache
+     */
+    constexpr size_t ntt_block_size = 1 << 12;
+
+    /** roots[h + j] = w_{2h}^j for every power of two h < size, in Montgomery form
+     */
+    struct ntt_twiddle_table
+    {
+        std::vector<limb> roots, inverse_roots;
+    };
+
+    std::shared_ptr<const ntt_twiddle_table> ntt_twiddles(size_t prime_index, size_t n)
+    {
+        static std::mutex mutex;
+        static std::shared_ptr<const ntt_twiddle_table> tables[std::size(ntt_primes)];
+
+        n = std::max<size_t>(n, 2);
+
+        std::lock_guard lock(mutex);
+
+        auto &table = tables[prime_index];
+
+        if (table && table->roots.size() >= n)
+            return table;
+
+        const ntt_prime &prime = ntt_primes[prime_index];
+        auto res = std::make_shared<ntt_twiddle_table>();
+        res->roots.resize(n);
+        res->inverse_roots.resize(n);
+
+        size_t h = n / 2;
+        limb w = prime.pow(prime.to_montgomery(prime.generator), (prime.p - 1) / n);
+        limb w_inv = prime.pow(w, prime.p - 2);
+        limb cur = prime.one(), cur_inv = prime.one();
+
+        for (size_t j = 0; j < h; ++j)
+        {
+            res->roots[h + j] = cur;
+            res->inverse_roots[h + j] = cur_inv;
+            cur = prime.mul(cur, w);
+            cur_inv = prime.mul(cur_inv, w_inv);
+        }
+
+        for (h /= 2; h >= 1; h /= 2)
+        {
+            for (size_t j = 0; j < h; ++j)
+            {
+                res->roots[h + j] = res->roots[2 * h + 2 * j];
+                res->inverse_roots[h + j] = res->inverse_roots[2 * h + 2 * j];
+            }
+        }
+
+        table = res;
+        return table;
+    }
+
+    /** Decimation in frequency, natural order in, bit-reversed order out.
+     *  Levels above depth fork both halves and split their butterfly sweeps into chunks
+     */
+    void ntt_forward(limb *a, size_t n, const limb *roots, const ntt_prime prime, size_t depth = 0)
+    {
+        if (n > ntt_block_size)
+        {
+            size_t h = n / 2;
+
+            parallel_for(0, h, size_t(1) << depth, [=](size_t lo, size_t hi)
+            {
+                for (size_t j = lo; j < hi; ++j)
+                {
+                    limb x = a[j], y = a[j + h];
+                    a[j] = prime.add(x, y);
+                    a[j + h] = prime.mul(prime.sub(x, y), roots[h + j]);
+                }
+            });
+
+            if (depth == 0)
+            {
+                ntt_forward(a, h, roots, prime);
+                ntt_forward(a + h, h, roots, prime);
+                return;
+            }
+
+            task_group group;
+            group.run([=] { ntt_forward(a + h, h, roots, prime, depth - 1); });
+            ntt_forward(a, h, roots, prime, depth - 1);
+            group.wait();
+            return;
+        }
+
+        for (size_t h = n / 2; h >= 1; h /= 2)
+        {
+            for (size_t start = 0; start < n; start += 2 * h)
+            {
+                for (size_t j = 0; j < h; ++j)
+                {
+                    limb x = a[start + j], y = a[start + j + h];
+                    a[start + j] = prime.add(x, y);
+                    a[start + j + h] = prime.mul(prime.sub(x, y), roots[h + j]);
+                }
+            }
+        }
+    }
+
+    /** Decimation in time with inverse roots, bit-reversed order in, natural order out, not scaled
+     */
+    void ntt_inverse(limb *a, size_t n, const limb *inverse_roots, const ntt_prime prime, size_t depth = 0)
+    {
+        if (n > ntt_block_size)
+        {
+            size_t h = n / 2;
+
+            if (depth == 0)
+            {
+                ntt_inverse(a, h, inverse_roots, prime);
+                ntt_inverse(a + h, h, inverse_roots, prime);
+            } else
+            {
+                task_group group;
+                group.run([=] { ntt_inverse(a + h, h, inverse_roots, prime, depth - 1); });
+                ntt_inverse(a, h, inverse_roots, prime, depth - 1);
+                group.wait();
+            }
+
+            parallel_for(0, h, size_t(1) << depth, [=](size_t lo, size_t hi)
+            {
+                for (size_t j = lo; j < hi; ++j)
+                {
+                    limb x = a[j], y = prime.mul(a[j + h], inverse_roots[h + j]);
+                    a[j] = prime.add(x, y);
+                    a[j + h] = prime.sub(x, y);
+                }
+            });
+            return;
+        }
+
+        for (size_t h = 1; h < n; h *= 2)
+        {
+            for (size_t start = 0; start < n; start += 2 * h)
+            {
+                for (size_t j = 0; j < h; ++j)
+                {
+                    limb x = a[start + j], y = prime.mul(a[start + j + h], inverse_roots[h + j]);
+                    a[start + j] = prime.add(x, y);
+                    a[start + j + h] = prime.sub(x, y);
+                }
+            }
+        }
+    }
+
+    /** Cyclic convolution of a and b modulo one prime, result (plain residues) is written to fa[0, n)
+     */
+    void ntt_convolve(limb *fa, limb *fb, size_t n, const limb *a, size_t an, const limb *b, size_t bn, bool square, size_t prime_index, size_t depth)
+    {
+        const ntt_prime prime = ntt_primes[prime_index]; // local copy, otherwise writes through limb pointers force reloads
+        auto twiddles = ntt_twiddles(prime_index, n);
+        const limb *roots = twiddles->roots.data();
+
+        auto load = [=](limb *f, const limb *x, size_t xn)
+        {
+            for (size_t i = 0; i < xn; ++i)
+                f[i] = prime.to_montgomery(x[i]);
+            std::fill(f + xn, f + n, 0);
+            ntt_forward(f, n, roots, prime, depth);
+        };
+
+        if (square)
+        {
+            load(fa, a, an);
+
+            for (size_t i = 0; i < n; ++i)
+                fa[i] = prime.mul(fa[i], fa[i]);
+        } else
+        {
+            if (depth == 0)
+            {
+                load(fa, a, an);
+                load(fb, b, bn);
+            } else
+            {
+                task_group group;
+                group.run([=] { load(fb, b, bn); });
+                load(fa, a, an);
+                group.wait();
+            }
+
+            for (size_t i = 0; i < n; ++i)
+                fa[i] = prime.mul(fa[i], fb[i]);
+        }
+
+        ntt_inverse(fa, n, twiddles->inverse_roots.data(), prime, depth);
+
+        // multiplying Montgomery form by plain n^-1 leaves plain residue
+        limb n_inv = prime.inverse(n % prime.p);
+
+        for (size_t i = 0; i < n; ++i)
+            fa[i] = prime.mul(fa[i], n_inv);
+    }
+
+    /** Garner's recombination constants for ntt_primes
+     */
+    struct ntt_crt_constants
+    {
+        limb p1_inv_mod_p2; // Montgomery form modulo p2
+        limb p1p2_inv_mod_p3; // Montgomery form modulo p3
+        limb p1_mod_p3; // Montgomery form modulo p3
+        limb p1p2_lo, p1p2_hi;
+
+        constexpr ntt_crt_constants() noexcept : p1_inv_mod_p2(0), p1p2_inv_mod_p3(0), p1_mod_p3(0), p1p2_lo(0), p1p2_hi(0)
+        {
+            const ntt_prime &p1 = ntt_primes[0], &p2 = ntt_primes[1], &p3 = ntt_primes[2];
+
+            p1_inv_mod_p2 = p2.to_montgomery(p2.inverse(p1.p % p2.p));
+            p1_mod_p3 = p3.to_montgomery(p1.p % p3.p);
+            p1p2_inv_mod_p3 = p3.to_montgomery(p3.inverse(p3.reduce(0, p3.mul(p3.to_montgomery(p1.p % p3.p), p3.to_montgomery(p2.p % p3.p)))));
+            p1p2_lo = __detail::multiply_wide(p1.p, p2.p, p1p2_hi);
+        }
+    };
+
+    constexpr ntt_crt_constants ntt_crt;
+
+    /** Writes r[begin, end) from CRT of residues, returns what has to be added to r starting at end
+     */
+    std::array<limb, 3> ntt_crt_range(limb *r, limb *const residues[3], size_t begin, size_t end, size_t coefficients) noexcept
+    {
+        const ntt_prime p2 = ntt_primes[1], p3 = ntt_primes[2];
+        limb p1 = ntt_primes[0].p;
+
+        std::array<limb, 3> acc = {0, 0, 0};
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (i < coefficients)
+            {
+                limb r1 = residues[0][i], r2 = residues[1][i], r3 = residues[2][i];
+
+                limb v1 = r1;
+                limb v2 = p2.mul(p2.sub(r2, v1 >= p2.p ? v1 - p2.p : v1), ntt_crt.p1_inv_mod_p2);
+                limb v12_mod_p3 = p3.add(v1 >= p3.p ? v1 - p3.p : v1, p3.mul(v2, ntt_crt.p1_mod_p3));
+                limb v3 = p3.mul(p3.sub(r3, v12_mod_p3), ntt_crt.p1p2_inv_mod_p3);
+
+                // x = v1 + v2 * p1 + v3 * p1 * p2
+                limb x[3];
+                x[0] = __detail::multiply_wide(v2, p1, x[1]);
+                x[2] = 0;
+                limb carry = 0;
+                x[0] = __detail::add_with_carry(x[0], v1, carry);
+                x[1] = __detail::add_with_carry(x[1], 0, carry);
+
+                limb t_hi, u_hi;
+                limb t_lo = __detail::multiply_wide(v3, ntt_crt.p1p2_lo, t_hi);
+                limb u_lo = __detail::multiply_wide(v3, ntt_crt.p1p2_hi, u_hi);
+                carry = 0;
+                t_hi = __detail::add_with_carry(t_hi, u_lo, carry);
+                u_hi += carry;
+
+                carry = 0;
+                x[0] = __detail::add_with_carry(x[0], t_lo, carry);
+                x[1] = __detail::add_with_carry(x[1], t_hi, carry);
+                x[2] = __detail::add_with_carry(x[2], u_hi, carry);
+
+                carry = 0;
+                acc[0] = __detail::add_with_carry(acc[0], x[0], carry);
+                acc[1] = __detail::add_with_carry(acc[1], x[1], carry);
+                acc[2] = __detail::add_with_carry(acc[2], x[2], carry);
+            }
+
+            r[i] = acc[0];
+            acc[0] = acc[1];
+            acc[1] = acc[2];
+            acc[2] = 0;
+        }
+
+        return acc;
+    }
+
+    /** r[0, an + bn) = a * b via convolutions modulo three primes and CRT, products of limbs are exact up to 2^57 coefficients.
+     *  With threads > 1 the three primes, both transforms and the recombination run in parallel
+     */
+    void limbs_mul_ntt(limb *r, const limb *a, size_t an, const limb *b, size_t bn, bool square, pp_allocator<limb> allocator, size_t threads = 1)
+    {
+        size_t rn = an + bn;
+        size_t n = __detail::nearest_greater_power_of_2(rn - 1);
+        size_t primes = std::size(ntt_primes);
+
+        // every prime gets its own second operand buffer when they run concurrently
+        size_t fb_count = square ? 0 : (threads > 1 ? primes : 1);
+        limb_vector buffer((primes + fb_count) * n, allocator);
+
+        limb *residues[3];
+        for (size_t k = 0; k < primes; ++k)
+            residues[k] = buffer.data() + k * n;
+
+        auto fb = [&](size_t k) -> limb *
+        {
+            return fb_count == 0 ? nullptr : buffer.data() + (primes + (fb_count == 1 ? 0 : k)) * n;
+        };
+
+        if (threads <= 1)
+        {
+            for (size_t k = 0; k < primes; ++k)
+                ntt_convolve(residues[k], fb(k), n, a, an, b, bn, square, k, 0);
+
+            ntt_crt_range(r, residues, 0, rn, rn - 1);
+            return;
+        }
+
+        size_t depth = parallel_depth((threads + primes - 1) / primes, 2);
+
+        {
+            task_group group;
+            for (size_t k = 1; k < primes; ++k)
+                group.run([=, &residues] { ntt_convolve(residues[k], fb(k), n, a, an, b, bn, square, k, depth); });
+            ntt_convolve(residues[0], fb(0), n, a, an, b, bn, square, 0, depth);
+            group.wait();
+        }
+
+        size_t chunk = (rn + threads - 1) / threads;
+        std::vector<std::array<limb, 3>> carries(threads);
+
+        parallel_for(0, threads, threads, [&](size_t lo, size_t hi)
+        {
+            for (size_t t = lo; t < hi; ++t)
+            {
+                size_t begin = std::min(t * chunk, rn), end = std::min(begin + chunk, rn);
+                carries[t] = ntt_crt_range(r, residues, begin, end, rn - 1);
+            }
+        });
+
+        for (size_t t = 0; t + 1 < threads; ++t)
+        {
+            size_t end = std::min((t + 1) * chunk, rn);
+            size_t len = std::min<size_t>(3, rn - end);
+            if (len != 0)
+                limbs_add(r + end, r + end, rn - end, carries[t].data(), len);
+        }
+    }
+
+    /** Reciprocal of normalised d: floor((2^128 - 1) / d) - 2^64
+     */
+    limb limb_reciprocal(limb d) noexcept
+    {
+        limb rem;
+        return __detail::divide_wide(~d, ~limb(0), d, rem);
+    }
+
+    /** Division of (nh, nl) by normalised d with precomputed reciprocal, requires nh < d
+     */
+    limb divide_2by1_preinv(limb nh, limb nl, limb d, limb v, limb &rem) noexcept
+    {
+        limb q_hi;
+        limb q_lo = __detail::multiply_wide(v, nh, q_hi);
+
+        limb carry = 0;
+        q_lo = __detail::add_with_carry(q_lo, nl, carry);
+        q_hi = __detail::add_with_carry(q_hi, nh + 1, carry);
+
+        limb r = nl - q_hi * d;
+
+        if (r > q_lo)
+        {
+            --q_hi;
+            r += d;
+        }
+
+        if (r >= d)
+        {
+            ++q_hi;
+            r -= d;
+        }
+
+        rem = r;
+        return q_hi;
+    }
+
+    /** q = a / d, returns a % d, q may be equal to a
+     */
+    limb limbs_divrem_1(limb *q, const limb *a, size_t n, limb d) noexcept
+    {
+        unsigned shift = std::countl_zero(d);
+        limb dn = d << shift;
+        limb v = limb_reciprocal(dn);
+        limb r = 0;
+
+        if (shift == 0)
+        {
+            for (size_t i = n; i-- > 0;)
+                q[i] = divide_2by1_preinv(r, a[i], dn, v, r);
+
+            return r;
+        }
+
+        r = a[n - 1] >> (limb_bits - shift);
+
+        for (size_t i = n; i-- > 0;)
+        {
+            limb nl = (a[i] << shift) | (i > 0 ? a[i - 1] >> (limb_bits - shift) : 0);
+            q[i] = divide_2by1_preinv(r, nl, dn, v, r);
+        }
+
+        return r >> shift;
+    }
+
+    /** a % d without quotient
+     */
+    limb limbs_mod_1(const limb *a, size_t n, limb d) noexcept
+    {
+        unsigned shift = std::countl_zero(d);
+        limb dn = d << shift;
+        limb v = limb_reciprocal(dn);
+        limb r = 0; // remainder times 2^shift
+
+        for (size_t i = n; i-- > 0;)
+        {
+            limb nh = shift == 0 ? r : r | (a[i] >> (limb_bits - shift));
+            divide_2by1_preinv(nh, a[i] << shift, dn, v, r);
+        }
+
+        return r >> shift;
+    }
+
+    /** Schoolbook division (Knuth, algorithm D) in place.
+     *  q[0, an - dn) = a / d, remainder replaces a[0, dn); requires normalised d and a[an - dn, an) < d
+     */
+    void limbs_div_schoolbook(limb *q, limb *a, size_t an, const limb *d, size_t dn) noexcept
+    {
+        limb d_hi = d[dn - 1];
+        limb v = limb_reciprocal(d_hi);
+
+        if (dn == 1)
+        {
+            limb r = a[an - 1];
+
+            for (size_t j = an - 1; j-- > 0;)
+                q[j] = divide_2by1_preinv(r, a[j], d_hi, v, r);
+
+            a[0] = r;
+            return;
+        }
+
+        limb d_lo = d[dn - 2];
+
+        for (size_t j = an - dn; j-- > 0;)
+        {
+            limb n_2 = a[j + dn], n_1 = a[j + dn - 1], n_0 = a[j + dn - 2];
+            limb q_hat, r_hat;
+            bool r_hat_overflow = false;
+
+            if (n_2 >= d_hi)
+            {
+                q_hat = ~limb(0);
+                r_hat = n_1 + d_hi;
+                r_hat_overflow = r_hat < n_1;
+            } else
+            {
+                q_hat = divide_2by1_preinv(n_2, n_1, d_hi, v, r_hat);
+            }
+
+            while (!r_hat_overflow)
+            {
+                limb p_hi;
+                limb p_lo = __detail::multiply_wide(q_hat, d_lo, p_hi);
+
+                if (p_hi < r_hat || (p_hi == r_hat && p_lo <= n_0))
+                    break;
+
+                --q_hat;
+                r_hat += d_hi;
+                r_hat_overflow = r_hat < d_hi;
+            }
+
+            limb borrow = limbs_submul_1(a + j, d, dn, q_hat);
+
+            if (a[j + dn] < borrow)
+            {
+                --q_hat;
+                a[j + dn] += limbs_add_n(a + j, a + j, d, dn);
+            }
+
+            a[j + dn] -= borrow;
+            q[j] = q_hat;
+        }
+    }
+
+    /** r[0, an + bn) = a * b for division subproducts: Toom-Cook or Karatsuba (forked for depth levels) from ws holding
+     *  toom_scratch_size(max(an, bn), depth) limbs, or NTT above its threshold, which is then the only allocation
+     */
+    void limbs_mul_workspace(limb *r, const limb *a, size_t an, const limb *b, size_t bn, limb *ws, size_t depth, size_t threads, pp_allocator<limb> allocator)
+    {
+        if (std::min(an, bn) >= std::max<size_t>(big_int::ntt_threshold, 1))
+            limbs_mul_ntt(r, a, an, b, bn, false, allocator, threads);
+        else
+            limbs_mul_toom(r, a, an, b, bn, ws, depth, true);
+    }
+
+    /** Same on calling thread with own scratch
+     */
+    void limbs_mul(limb *r, const limb *a, size_t an, const limb *b, size_t bn, pp_allocator<limb> allocator)
+    {
+        limb_vector scratch(toom_scratch_size(std::max(an, bn), 0), 0, allocator);
+        limbs_mul_workspace(r, a, an, b, bn, scratch.data(), 0, 1, allocator);
+    }
+
+    size_t burnikel_ziegler_cutoff() noexcept
+    {
+        return std::max<size_t>(big_int::burnikel_ziegler_threshold, 2);
+    }
+
+
+    /** Workspace limbs for Burnikel-Ziegler block steps with n-limb divisor.
+     *  Recursive calls are finished before a level multiplies, so all levels share one area
+     */
+    size_t burnikel_ziegler_workspace_size(size_t n, size_t depth) noexcept
+    {
+        size_t own = n + toom_scratch_size(n, depth);
+
+        if (n < burnikel_ziegler_cutoff())
+            return own;
+
+        return std::max(burnikel_ziegler_workspace_size((n + 1) / 2, depth), own);
+    }
+
+    struct burnikel_ziegler_context
+    {
+        limb *ws;
+        size_t threads;
+        size_t depth; // of parallel Karatsuba
+        pp_allocator<limb> allocator;
+    };
+
+    void limbs_div_3by2(limb *q, limb *a, const limb *d, size_t n, size_t k, const burnikel_ziegler_context &context);
+
+    /** q[0, n) = a[0, 2n) / d, remainder replaces a[0, n); requires normalised d and a[n, 2n) < d
+     */
+    void limbs_div_2by1(limb *q, limb *a, const limb *d, size_t n, const burnikel_ziegler_context &context)
+    {
+        if (n < burnikel_ziegler_cutoff())
+        {
+            limbs_div_schoolbook(q, a, 2 * n, d, n);
+            return;
+        }
+
+        size_t lo = n / 2, hi = n - lo;
+
+        limbs_div_3by2(q + lo, a + lo, d, n, hi, context);
+        limbs_div_3by2(q, a, d, n, lo, context);
+    }
+
+    /** q[0, k) = a[0, n + k) / d for k <= n, remainder replaces a[0, n); requires normalised d and a[k, n + k) < d.
+     *  Estimates quotient from the top k limbs of d and corrects it at most twice
+     */
+    void limbs_div_3by2(limb *q, limb *a, const limb *d, size_t n, size_t k, const burnikel_ziegler_context &context)
+    {
+        const limb *d_hi = d + n - k;
+        limb *a_hi = a + n - k;
+        limb carry = 0;
+
+        if (limbs_compare(a + n, k, d_hi, k) == 0)
+        {
+            // estimate B^k - 1 leaves a_hi - (B^k - 1) * d_hi = a_hi[0, k) + d_hi
+            std::fill(q, q + k, ~limb(0));
+            carry = limbs_add_n(a_hi, a_hi, d_hi, k);
+        } else
+        {
+            limbs_div_2by1(q, a_hi, d_hi, k, context);
+        }
+
+        if (n == k)
+            return;
+
+        limb *product = context.ws;
+        limbs_mul_workspace(product, q, k, d, n - k, context.ws + n, context.depth, context.threads, context.allocator);
+
+        limb borrow = limbs_sub_n(a, a, product, n);
+
+        while (carry < borrow)
+        {
+            limbs_sub_1(q, q, k, 1);
+            carry += limbs_add_n(a, a, d, n);
+        }
+    }
+
+    /** Normalises operands and runs block steps of Burnikel-Ziegler division.
+     *  q[0, an - bn + 1) = a / b, r[0, bn) = a % b; requires an >= bn and b[bn - 1] != 0
+     */
+    void limbs_divrem_burnikel_ziegler(limb *q, limb *r, const limb *a, size_t an, const limb *b, size_t bn, pp_allocator<limb> allocator, size_t threads)
+    {
+        unsigned shift = std::countl_zero(b[bn - 1]);
+        if (bn < big_int::parallel_threshold)
+            threads = 1;
+
+        size_t depth = threads > 1 ? parallel_depth(threads, 3) : 0;
+
+        limb_vector buffer(bn + an + 1 + burnikel_ziegler_workspace_size(bn, depth), 0, allocator);
+        limb *d = buffer.data(), *un = d + bn;
+
+        if (shift != 0)
+        {
+            limbs_lshift(d, b, bn, shift);
+            un[an] = limbs_lshift(un, a, an, shift);
+        } else
+        {
+            std::copy(b, b + bn, d);
+            std::copy(a, a + an, un);
+        }
+
+        burnikel_ziegler_context context{un + an + 1, threads, depth, allocator};
+
+        // top chunk takes the remainder so the others are full n-limb blocks
+        for (size_t qn = an + 1 - bn; qn > 0;)
+        {
+            size_t k = qn % bn == 0 ? bn : qn % bn;
+            qn -= k;
+            limbs_div_3by2(q + qn, un + qn, d, bn, k, context);
+        }
+
+        if (shift != 0)
+            limbs_rshift(r, un, bn, shift);
+        else
+            std::copy(un, un + bn, r);
+    }
+
+    /** x[0, n + 1) approximates floor(B^2n / d) for normalised d within a few units.
+     *  One Newton step x = y + y * (B^2n - d * y) / B^2n from the reciprocal y of top n / 2 + 1 limbs
+     */
+    void limbs_reciprocal_approx(limb *x, const limb *d, size_t n, pp_allocator<limb> allocator)
+    {
+        if (n < std::max<size_t>(karatsuba_cutoff(), 3))
+        {
+            limb_vector numerator(2 * n + 1, 0, allocator);
+            numerator[2 * n] = 1;
+            limbs_div_schoolbook(x, numerator.data(), 2 * n + 1, d, n);
+            return;
+        }
+
+        size_t h = n / 2 + 1;
+
+        limb_vector buffer((h + 1) + (n + h + 1) + (n + 1) + (n + h + 2), 0, allocator);
+        limb *y = buffer.data(), *product = y + h + 1, *e = product + n + h + 1, *correction = e + n + 1;
+
+        limbs_reciprocal_approx(y, d + n - h, h, allocator);
+
+        // e = B^(n + h) - d * y, |e| < B^(n + 1) so its low limbs are enough
+        limbs_mul(product, d, n, y, h + 1, allocator);
+        bool negative = product[n + h] != 0;
+
+        if (negative)
+        {
+            std::copy(product, product + n + 1, e);
+        } else
+        {
+            for (size_t i = 0; i <= n; ++i)
+                e[i] = ~product[i];
+            limbs_add_1(e, e, n + 1, 1);
+        }
+
+        limbs_mul(correction, y, h + 1, e, n + 1, allocator);
+
+        std::fill(x, x + n + 1, 0);
+        std::copy(y, y + h + 1, x + n - h);
+
+        if (negative)
+            limbs_sub(x, x, n + 1, correction + 2 * h, n - h + 2);
+        else
+            limbs_add(x, x, n + 1, correction + 2 * h, n - h + 2);
+    }
+
+    /** x[0, n + 1) = floor(B^2n / d) for normalised d
+     */
+    void limbs_reciprocal(limb *x, const limb *d, size_t n, pp_allocator<limb> allocator)
+    {
+        limbs_reciprocal_approx(x, d, n, allocator);
+
+        // r = B^2n - d * x in 2n + 1 limbs of two's complement
+        limb_vector r(2 * n + 1, 0, allocator), product(2 * n + 1, 0, allocator);
+        r[2 * n] = 1;
+        limbs_mul(product.data(), d, n, x, n + 1, allocator);
+
+        limb negative = limbs_sub_n(r.data(), r.data(), product.data(), 2 * n + 1);
+
+        while (negative != 0)
+        {
+            limbs_sub_1(x, x, n + 1, 1);
+            negative -= limbs_add(r.data(), r.data(), 2 * n + 1, d, n);
+        }
+
+        while (limbs_compare_padded(r.data(), 2 * n + 1, d, n) >= 0)
+        {
+            limbs_add_1(x, x, n + 1, 1);
+            limbs_sub(r.data(), r.data(), 2 * n + 1, d, n);
+        }
+    }
+
+    size_t barrett_workspace_size(size_t n) noexcept
+    {
+        return 4 * n + 2 + toom_scratch_size(n + 1, 0);
+    }
+
+    /** q[0, k) = a[0, n + k) / d for k <= n with x = floor(B^2n / d), remainder replaces a[0, n);
+     *  requires normalised d and a[k, n + k) < d. Barrett estimate from top k + 1 limbs of a is at most 2 too small
+     */
+    void limbs_div_barrett_step(limb *q, limb *a, const limb *d, size_t n, size_t k, const limb *x, limb *ws, pp_allocator<limb> allocator)
+    {
+        limb *estimate = ws, *product = ws + n + k + 2, *rest = product + n + k;
+
+        limbs_mul_workspace(estimate, x, n + 1, a + n - 1, k + 1, rest, 0, 1, allocator);
+        std::copy(estimate + n + 1, estimate + n + 1 + k, q);
+
+        limbs_mul_workspace(product, q, k, d, n, rest, 0, 1, allocator);
+        limbs_sub_n(a, a, product, n + k);
+
+        // remainder is below 3d, so it fits n + 1 limbs
+        while (a[n] != 0 || limbs_compare(a, n, d, n) >= 0)
+        {
+            a[n] -= limbs_sub_n(a, a, d, n);
+            limbs_add_1(q, q, k, 1);
+        }
+    }
+
+    /** q[0, an - n) = a / d by blocks of n limbs, remainder replaces a[0, n); requires normalised d and a[an - n, an) < d
+     */
+    void limbs_div_barrett(limb *q, limb *a, size_t an, const limb *d, size_t n, const limb *x, pp_allocator<limb> allocator)
+    {
+        limb_vector workspace(barrett_workspace_size(n), 0, allocator);
+
+        for (size_t qn = an - n; qn > 0;)
+        {
+            size_t k = qn % n == 0 ? n : qn % n;
+            qn -= k;
+            limbs_div_barrett_step(q + qn, a + qn, d, n, k, x, workspace.data(), allocator);
+        }
+    }
+
+    /** Normalises operands and divides by Newton reciprocal of divisor.
+     *  q[0, an - bn + 1) = a / b, r[0, bn) = a % b; requires an >= bn and b[bn - 1] != 0
+     */
+    void limbs_divrem_newton(limb *q, limb *r, const limb *a, size_t an, const limb *b, size_t bn, pp_allocator<limb> allocator)
+    {
+        unsigned shift = std::countl_zero(b[bn - 1]);
+
+        limb_vector buffer(bn + an + 1 + bn + 1, 0, allocator);
+        limb *d = buffer.data(), *un = d + bn, *x = un + an + 1;
+
+        if (shift != 0)
+        {
+            limbs_lshift(d, b, bn, shift);
+            un[an] = limbs_lshift(un, a, an, shift);
+        } else
+        {
+            std::copy(b, b + bn, d);
+            std::copy(a, a + an, un);
+        }
+
+        limbs_reciprocal(x, d, bn, allocator);
+        limbs_div_barrett(q, un, an + 1, d, bn, x, allocator);
+
+        if (shift != 0)
+            limbs_rshift(r, un, bn, shift);
+        else
+            std::copy(un, un + bn, r);
+    }
+
+    /** Normalises operands for schoolbook division.
+     *  q[0, an - bn + 1) = a / b, r[0, bn) = a % b; requires an >= bn >= 2 and b[bn - 1] != 0
+     */
+    void limbs_divrem(limb *q, limb *r, const limb *a, size_t an, const limb *b, size_t bn, pp_allocator<limb> allocator)
+    {
+        unsigned shift = std::countl_zero(b[bn - 1]);
+
+        limb_vector vn(b, b + bn, allocator);
+        limb_vector un(an + 1, 0, allocator);
+
+        if (shift != 0)
+        {
+            limbs_lshift(vn.data(), vn.data(), bn, shift);
+            un[an] = limbs_lshift(un.data(), a, an, shift);
+        } else
+        {
+            std::copy(a, a + an, un.begin());
+        }
+
+        limbs_div_schoolbook(q, un.data(), an + 1, vn.data(), bn);
+
+        if (shift != 0)
+            limbs_rshift(r, un.data(), bn, shift);
+        else
+            std::copy(un.begin(), un.begin() + bn, r);
+    }
+
+    /** Hensel (2-adic) division of a[0, qn + dn) by odd d: q[0, qn) = a / d mod B^qn, and a - q * d replaces a,
+     *  so a[0, qn) becomes zero. Returns borrow out of a[qn + dn). d_inv = d^-1 mod B.
+     *  Quotient limbs come from the low end, each by one multiplication with d_inv (Jebelean's exact division)
+     */
+    limb limbs_bdiv_qr_schoolbook(limb *q, limb *a, size_t qn, const limb *d, size_t dn, limb d_inv) noexcept
+    {
+        limb borrow = 0;
+
+        for (size_t i = 0; i < qn; ++i)
+        {
+            limb qi = a[i] * d_inv;
+            q[i] = qi;
+            borrow += limbs_sub_1(a + i + dn, a + i + dn, qn - i, limbs_submul_1(a + i, d, dn, qi));
+        }
+
+        return borrow;
+    }
+
+    size_t bdiv_cutoff() noexcept
+    {
+        return std::max<size_t>(big_int::burnikel_ziegler_threshold, 2);
+    }
+
+    /** Same by divide and conquer, like Burnikel-Ziegler from the low end: balanced division is split into two halves
+     *  of quotient, each with low half of d by recursion and high half of d by one product. Long quotient is found
+     *  in blocks of dn limbs
+     */
+    limb limbs_bdiv_qr(limb *q, limb *a, size_t qn, const limb *d, size_t dn, limb d_inv, pp_allocator<limb> allocator)
+    {
+        if (qn < bdiv_cutoff() || dn < bdiv_cutoff())
+            return limbs_bdiv_qr_schoolbook(q, a, qn, d, dn, d_inv);
+
+        limb borrow = 0;
+
+        if (qn > dn)
+        {
+            for (size_t offset = 0; offset < qn; offset += dn)
+            {
+                size_t k = std::min(dn, qn - offset), top = offset + k + dn;
+                limb block_borrow = limbs_bdiv_qr(q + offset, a + offset, k, d, dn, d_inv, allocator);
+                borrow += limbs_sub_1(a + top, a + top, qn + dn - top, block_borrow);
+            }
+
+            return borrow;
+        }
+
+        if (qn < dn)
+        {
+            // a -= q * (d_low + d_high * B^qn), d_low part by recursion
+            borrow = limbs_bdiv_qr(q, a, qn, d, qn, d_inv, allocator);
+            borrow = limbs_sub_1(a + 2 * qn, a + 2 * qn, dn - qn, borrow);
+
+            limb_vector product(dn, 0, allocator);
+
+            if (qn >= dn - qn)
+                limbs_mul(product.data(), q, qn, d + qn, dn - qn, allocator);
+            else
+                limbs_mul(product.data(), d + qn, dn - qn, q, qn, allocator);
+
+            return borrow + limbs_sub_n(a + qn, a + qn, product.data(), dn);
+        }
+
+        size_t low = qn / 2, high = qn - low;
+
+        borrow = limbs_bdiv_qr(q, a, low, d, dn, d_inv, allocator);
+        borrow = limbs_sub_1(a + low + dn, a + low + dn, high, borrow);
+        return borrow + limbs_bdiv_qr(q + low, a + low, high, d, dn, d_inv, allocator);
+    }
+
+    /** Montgomery arithmetic modulo odd m of n limbs with R = B^n, residues are kept as n-limb vectors below m.
+     *  In constant-time mode products are schoolbook and the final subtraction of REDC is masked, so running time
+     *  does not depend on the residues
+     */
+    class montgomery_context final
+    {
+        const limb *_m;
+        size_t _n;
+        limb _m_inv; // -m^-1 mod B
+        bool _constant_time;
+        limb_vector _product;
+        limb_vector _scratch;
+
+    public:
+
+        montgomery_context(const limb *m, size_t n, bool constant_time, pp_allocator<limb> allocator)
+            : _m(m), _n(n), _m_inv(0), _constant_time(constant_time), _product(2 * n, 0, allocator),
+              _scratch(constant_time ? 0 : karatsuba_scratch_size(n), 0, allocator)
+        {
+            // Newton iteration doubles correct low bits, m0 * m0 = 1 mod 8 gives first three
+            limb inv = m[0];
+            for (int i = 0; i < 5; ++i)
+                inv *= 2 - m[0] * inv;
+
+            _m_inv = limb(0) - inv;
+        }
+
+        size_t size() const noexcept
+        {
+            return _n;
+        }
+
+        /** r = a * b / R mod m, r may alias a or b
+         */
+        void mul(limb *r, const limb *a, const limb *b)
+        {
+            if (_constant_time)
+                limbs_mul_basecase(_product.data(), a, _n, b, _n);
+            else
+                limbs_mul_recursive(_product.data(), a, _n, b, _n, _scratch.data());
+
+            redc(r);
+        }
+
+        void sqr(limb *r, const limb *a)
+        {
+            if (_constant_time)
+                limbs_sqr_basecase(_product.data(), a, _n);
+            else
+                limbs_sqr_recursive(_product.data(), a, _n, _scratch.data());
+
+            redc(r);
+        }
+
+    private:
+
+        /** r = product / R mod m
+         */
+        void redc(limb *r) noexcept
+        {
+            limb *t = _product.data();
+            limb carry = 0;
+
+            for (size_t i = 0; i < _n; ++i)
+            {
+                limb c = limbs_addmul_1(t + i, _m, _n, t[i] * _m_inv);
+                limb cc = carry;
+                t[i + _n] = __detail::add_with_carry(t[i + _n], c, cc);
+                carry = cc;
+            }
+
+            // t[n, 2n) + carry * R < 2m
+            limb borrow = limbs_sub_n(r, t + _n, _m, _n);
+
+            if (_constant_time)
+            {
+                limb keep = limb(0) - (borrow & (carry ^ 1)); // all ones when t[n, 2n) < m
+
+                for (size_t i = 0; i < _n; ++i)
+                    r[i] = (t[_n + i] & keep) | (r[i] & ~keep);
+            } else if (borrow != carry)
+            {
+                std::copy(t + _n, t + 2 * _n, r);
+            }
+        }
+    };
+
+    void strip_zeros(limb_vector &digits) noexcept
+    {
+        while (!digits.empty() && digits.back() == 0)
+            digits.pop_back();
+    }
+
+    /** r[0, an + bn) = a * b by given rule, r must not overlap a or b. threads == 0 means big_int::parallelism
+     */
+    void multiply_magnitudes(limb *r, const limb *a, size_t an, const limb *b, size_t bn, big_int::multiplication_rule rule,
+                             size_t threads, const pp_allocator<limb> &allocator)
+    {
+        bool square = a == b && an == bn;
+
+        if (threads == 0)
+            threads = big_int::parallelism;
+        if (std::min(an, bn) < big_int::parallel_threshold)
+            threads = 1;
+
+        switch (rule)
+        {
+            case big_int::multiplication_rule::trivial:
+                if (square)
+                    limbs_sqr_basecase(r, a, an);
+                else
+                    limbs_mul_basecase(r, a, an, b, bn);
+                break;
+            case big_int::multiplication_rule::SchonhageStrassen:
+                limbs_mul_ntt(r, a, an, b, bn, square, allocator, threads);
+                break;
+            case big_int::multiplication_rule::Karatsuba:
+            {
+                // the only allocation besides the result, all recursion levels and tasks share it.
+                // Allocated here since custom allocators are not required to be thread-safe
+                size_t depth = threads > 1 ? parallel_depth(threads, 3) : 0;
+                limb_vector scratch(karatsuba_parallel_scratch_size(std::max(an, bn), depth), 0, allocator);
+
+                if (square)
+                    limbs_sqr_parallel(r, a, an, scratch.data(), depth);
+                else
+                    limbs_mul_parallel(r, a, an, b, bn, scratch.data(), depth);
+                break;
+            }
+            case big_int::multiplication_rule::Toom3:
+            case big_int::multiplication_rule::Toom4:
+            {
+                bool toom4 = rule == big_int::multiplication_rule::Toom4;
+                size_t depth = threads > 1 ? parallel_depth(threads, toom4 ? 7 : 5) : 0;
+                limb_vector scratch(toom_scratch_size(std::max(an, bn), depth), 0, allocator);
+
+                limbs_mul_toom(r, a, an, b, bn, scratch.data(), depth, toom4);
+                break;
+            }
+        }
+    }
+
+    /** Quotient and/or remainder of magnitudes, b must not be zero.
+     *  Outputs keep their storage unless they alias a or b, quotient and remainder must differ
+     */
+    void divide_magnitudes(const limb_vector &a, const limb_vector &b, limb_vector *quotient, limb_vector *remainder,
+                           big_int::division_rule rule = big_int::division_rule::trivial, size_t threads = 1)
+    {
+        auto allocator = a.get_allocator();
+
+        if (limbs_compare(a.data(), a.size(), b.data(), b.size()) < 0)
+        {
+            if (remainder != nullptr)
+                *remainder = a;
+            if (quotient != nullptr)
+                quotient->clear();
+            return;
+        }
+
+        limb_vector q_local(allocator);
+
+        if (b.size() == 1)
+        {
+            // limbs_divrem_1 works in place, so quotient may overwrite a
+            limb d = b[0];
+            limb_vector &q = quotient != nullptr && quotient != &b ? *quotient : q_local;
+            size_t an = a.size();
+
+            q.resize(an);
+            limb rem = limbs_divrem_1(q.data(), a.data(), an, d);
+
+            if (remainder != nullptr)
+                remainder->assign(rem != 0 ? 1 : 0, rem);
+
+            strip_zeros(q);
+
+            if (quotient != nullptr && &q == &q_local)
+                *quotient = std::move(q_local);
+            return;
+        }
+
+        auto reusable = [&](limb_vector *out) { return out != nullptr && out != &a && out != &b; };
+
+        limb_vector r_local(allocator);
+        limb_vector &q = reusable(quotient) ? *quotient : q_local;
+        limb_vector &r = reusable(remainder) ? *remainder : r_local;
+
+        q.assign(a.size() - b.size() + 1, 0);
+        r.assign(b.size(), 0);
+
+        switch (rule)
+        {
+            case big_int::division_rule::trivial:
+                limbs_divrem(q.data(), r.data(), a.data(), a.size(), b.data(), b.size(), allocator);
+                break;
+            case big_int::division_rule::Newton:
+                limbs_divrem_newton(q.data(), r.data(), a.data(), a.size(), b.data(), b.size(), allocator);
+                break;
+            case big_int::division_rule::BurnikelZiegler:
+                limbs_divrem_burnikel_ziegler(q.data(), r.data(), a.data(), a.size(), b.data(), b.size(), allocator, threads);
+                break;
+        }
+
+        strip_zeros(q);
+        strip_zeros(r);
+
+        if (quotient != nullptr && &q == &q_local)
+            *quotient = std::move(q_local);
+        if (remainder != nullptr && &r == &r_local)
+            *remainder = std::move(r_local);
+    }
+
+    /** Two's complement image of signed magnitude in n limbs, n must exceed magnitude size
+     */
+    limb_vector to_twos_complement(bool sign, const limb_vector &digits, size_t n)
+    {
+        limb_vector res(n, 0, digits.get_allocator());
+        std::copy(digits.begin(), digits.end(), res.begin());
+
+        if (!sign)
+        {
+            for (auto &d : res)
+                d = ~d;
+            limbs_add_1(res.data(), res.data(), n, 1);
+        }
+
+        return res;
+    }
+
+    /** Inverse of to_twos_complement, works in place
+     */
+    bool from_twos_complement(limb_vector &digits) noexcept
+    {
+        bool sign = digits.empty() || (digits.back() >> (limb_bits - 1)) == 0;
+
+        if (!sign)
+        {
+            for (auto &d : digits)
+                d = ~d;
+            limbs_add_1(digits.data(), digits.data(), digits.size(), 1);
+        }
+
+        strip_zeros(digits);
+        return sign;
+    }
+
+    /** Largest power of radix that fits in a limb and its exponent
+     */
+    std::pair<limb, size_t> radix_chunk(unsigned int radix) noexcept
+    {
+        limb power = radix;
+        size_t count = 1;
+
+        while (power <= ~limb(0) / radix)
+        {
+            power *= radix;
+            ++count;
+        }
+
+        return {power, count};
+    }
+
+    /** hi * p + lo, lo must be below p
+     */
+    limb_vector limbs_mul_add(const limb_vector &hi, const limb *p, size_t pn, const limb_vector &lo)
+    {
+        if (hi.empty())
+            return lo;
+
+        limb_vector res(hi.size() + pn + 1, 0, lo.get_allocator());
+        limbs_mul(res.data(), hi.data(), hi.size(), p, pn, lo.get_allocator());
+        limbs_add(res.data(), res.data(), res.size(), lo.data(), lo.size());
+
+        strip_zeros(res);
+        return res;
+    }
+
+    int char_to_digit(char c) noexcept
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'z')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'Z')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    constexpr char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+    /** Conversions switch to quadratic chunk-by-chunk loops below this many limbs
+     */
+    constexpr size_t radix_conversion_cutoff = 24;
+
+    /** (radix^chunk_digits)^(2^k) prepared for repeated division
+     */
+    struct radix_power
+    {
+        std::vector<limb> value;
+        unsigned int shift = 0;
+        std::vector<limb> normalised;
+        std::vector<limb> reciprocal; // floor(B^2n / normalised), empty below big_int::newton_threshold limbs
+    };
+
+    /** Level k of cached power tree of radix, levels are computed by squaring on first use
+     */
+    std::shared_ptr<const radix_power> radix_power_level(unsigned int radix, size_t k)
+    {
+        static std::mutex mutex;
+        static std::vector<std::shared_ptr<const radix_power>> tables[37];
+
+        std::lock_guard lock(mutex);
+
+        auto &table = tables[radix];
+
+        while (table.size() <= k)
+        {
+            auto res = std::make_shared<radix_power>();
+
+            if (table.empty())
+            {
+                res->value.assign(1, radix_chunk(radix).first);
+            } else
+            {
+                const auto &previous = table.back()->value;
+                res->value.resize(2 * previous.size());
+                limbs_mul(res->value.data(), previous.data(), previous.size(), previous.data(), previous.size(), pp_allocator<limb>());
+
+                while (res->value.back() == 0)
+                    res->value.pop_back();
+            }
+
+            size_t n = res->value.size();
+            res->shift = std::countl_zero(res->value.back());
+            res->normalised = res->value;
+
+            if (res->shift != 0)
+                limbs_lshift(res->normalised.data(), res->value.data(), n, res->shift);
+
+            if (n >= big_int::newton_threshold)
+            {
+                res->reciprocal.resize(n + 1);
+                limbs_reciprocal(res->reciprocal.data(), res->normalised.data(), n, pp_allocator<limb>());
+            }
+
+            table.push_back(std::move(res));
+        }
+
+        return table[k];
+    }
+
+    /** q = x / power and x = x % power, q holds xn - power size + 1 limbs, returns sizes of quotient and remainder
+     */
+    std::pair<size_t, size_t> limbs_divrem_radix_power(limb *q, limb *x, size_t xn, const radix_power &power, pp_allocator<limb> allocator)
+    {
+        size_t n = power.value.size();
+
+        if (limbs_compare(x, xn, power.value.data(), n) < 0)
+            return {0, xn};
+
+        limb_vector un(xn + 1, 0, allocator);
+
+        if (power.shift != 0)
+            un[xn] = limbs_lshift(un.data(), x, xn, power.shift);
+        else
+            std::copy(x, x + xn, un.begin());
+
+        if (power.reciprocal.empty())
+            limbs_div_schoolbook(q, un.data(), xn + 1, power.normalised.data(), n);
+        else
+            limbs_div_barrett(q, un.data(), xn + 1, power.normalised.data(), n, power.reciprocal.data(), allocator);
+
+        if (power.shift != 0)
+            limbs_rshift(x, un.data(), n, power.shift);
+        else
+            std::copy(un.begin(), un.begin() + n, x);
+
+        size_t qn = xn + 1 - n, rn = n;
+
+        while (qn > 0 && q[qn - 1] == 0)
+            --qn;
+        while (rn > 0 && x[rn - 1] == 0)
+            --rn;
+
+        return {qn, rn};
+    }
+
+    /** Writes x < radix^digits as exactly digits characters with leading zeros, x is destroyed.
+     *  Splits by level-th power of the tree, so halves have chunk_digits * 2^level digits
+     */
+    void limbs_to_radix(char *out, size_t digits, limb *x, size_t n, unsigned int radix, size_t level, pp_allocator<limb> allocator)
+    {
+        while (n > 0 && x[n - 1] == 0)
+            --n;
+
+        if (n < radix_conversion_cutoff || level == 0)
+        {
+            auto [chunk, chunk_digits] = radix_chunk(radix);
+            char *pos = out + digits;
+
+            while (n > 0)
+            {
+                limb rem = limbs_divrem_1(x, x, n, chunk);
+                n -= x[n - 1] == 0;
+
+                for (size_t i = 0; i < chunk_digits && pos != out; ++i, rem /= radix)
+                    *--pos = digit_chars[rem % radix];
+            }
+
+            std::fill(out, pos, '0');
+            return;
+        }
+
+        auto power = radix_power_level(radix, level - 1);
+        size_t low_digits = radix_chunk(radix).second << (level - 1);
+
+        limb_vector q(n + 1, 0, allocator);
+        auto [qn, rn] = limbs_divrem_radix_power(q.data(), x, n, *power, allocator);
+
+        limbs_to_radix(out, digits - low_digits, q.data(), qn, radix, level - 1, allocator);
+        limbs_to_radix(out + digits - low_digits, low_digits, x, rn, radix, level - 1, allocator);
+    }
+
+    /** Magnitude x as digits in radix, most significant first, without leading zeros
+     */
+    std::string limbs_to_string(const limb_vector &x, unsigned int radix)
+    {
+        if (x.empty())
+            return "0";
+
+        if (std::has_single_bit(radix))
+        {
+            // every digit is a group of bits
+            size_t bits = std::countr_zero(radix);
+            size_t total_bits = x.size() * limb_bits - std::countl_zero(x.back());
+            std::string res((total_bits + bits - 1) / bits, '0');
+
+            for (size_t i = 0; i < res.size(); ++i)
+            {
+                size_t pos = i * bits;
+                limb digit = x[pos / limb_bits] >> (pos % limb_bits);
+                if (pos % limb_bits + bits > limb_bits && pos / limb_bits + 1 < x.size())
+                    digit |= x[pos / limb_bits + 1] << (limb_bits - pos % limb_bits);
+                res[res.size() - 1 - i] = digit_chars[digit & (radix - 1)];
+            }
+
+            return res;
+        }
+
+        // smallest level whose square exceeds x
+        size_t level = 0;
+        while (2 * (radix_power_level(radix, level)->value.size() - 1) < x.size())
+            ++level;
+
+        size_t digits = radix_chunk(radix).second << (level + 1);
+        std::string res(digits, '0');
+
+        limb_vector tmp(x);
+        limbs_to_radix(res.data(), digits, tmp.data(), tmp.size(), radix, level + 1, x.get_allocator());
+
+        res.erase(0, std::min(res.find_first_not_of('0'), res.size() - 1));
+        return res;
+    }
+
+    /** Value of digit characters s[0, len), most significant first, splits at chunk_digits * 2^k digits.
+     *  @throws std::invalid_argument on character that is not a digit in radix
+     */
+    limb_vector limbs_from_radix(const char *s, size_t len, unsigned int radix, pp_allocator<limb> allocator)
+    {
+        if (std::has_single_bit(radix))
+        {
+            size_t bits = std::countr_zero(radix);
+            limb_vector res((len * bits + limb_bits - 1) / limb_bits, 0, allocator);
+
+            for (size_t i = 0; i < len; ++i)
+            {
+                int digit = char_to_digit(s[len - 1 - i]);
+
+                if (digit < 0 || static_cast<unsigned int>(digit) >= radix)
+                    throw std::invalid_argument("big_int: invalid digit in number string");
+
+                size_t pos = i * bits;
+                res[pos / limb_bits] |= static_cast<limb>(digit) << (pos % limb_bits);
+                if (pos % limb_bits + bits > limb_bits)
+                    res[pos / limb_bits + 1] |= static_cast<limb>(digit) >> (limb_bits - pos % limb_bits);
+            }
+
+            strip_zeros(res);
+            return res;
+        }
+
+        auto [chunk, chunk_digits] = radix_chunk(radix);
+
+        if (len <= chunk_digits * radix_conversion_cutoff)
+        {
+            limb_vector res(allocator);
+            res.reserve(len / chunk_digits + 1);
+
+            for (size_t pos = 0; pos < len;)
+            {
+                size_t count = std::min(chunk_digits, len - pos);
+                limb value = 0, power = 1;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    int digit = char_to_digit(s[pos + i]);
+
+                    if (digit < 0 || static_cast<unsigned int>(digit) >= radix)
+                        throw std::invalid_argument("big_int: invalid digit in number string");
+
+                    value = value * radix + digit;
+                    power *= radix;
+                }
+
+                if (count == chunk_digits)
+                    power = chunk;
+
+                limb carry = res.empty() ? 0 : limbs_mul_1(res.data(), res.data(), res.size(), power);
+                res.push_back(carry);
+
+                if (limbs_add_1(res.data(), res.data(), res.size(), value) != 0)
+                    res.push_back(1);
+
+                strip_zeros(res);
+                pos += count;
+            }
+
+            return res;
+        }
+
+        size_t level = 0;
+        while ((chunk_digits << (level + 1)) < len)
+            ++level;
+
+        size_t low_digits = chunk_digits << level;
+
+        limb_vector hi = limbs_from_radix(s, len - low_digits, radix, allocator);
+        limb_vector lo = limbs_from_radix(s + len - low_digits, low_digits, radix, allocator);
+        auto power = radix_power_level(radix, level);
+
+        return limbs_mul_add(hi, power->value.data(), power->value.size(), lo);
+    }
+}
+
+void big_int::optimise() noexcept
+{
+    strip_zeros(_digits);
+
+    if (_digits.empty())
+        _sign = true;
+}
+
+big_int::multiplication_rule big_int::decide_mult(size_t rhs) const noexcept
+{
+    size_t shorter = std::min(_digits.size(), rhs);
+
+    if (shorter >= ntt_threshold)
+        return multiplication_rule::SchonhageStrassen;
+
+    if (shorter >= toom4_cutoff())
+        return multiplication_rule::Toom4;
+
+    if (shorter >= toom3_cutoff())
+        return multiplication_rule::Toom3;
+
+    if (shorter >= karatsuba_cutoff())
+        return multiplication_rule::Karatsuba;
+
+    return multiplication_rule::trivial;
+}
+
+big_int::division_rule big_int::decide_div(size_t rhs) const noexcept
+{
+    if (rhs >= burnikel_ziegler_cutoff() && _digits.size() >= rhs + burnikel_ziegler_cutoff() / 2)
+        return division_rule::BurnikelZiegler;
+
+    return division_rule::trivial;
+}
 
 std::strong_ordering big_int::operator<=>(const big_int &other) const noexcept
 {
-    throw not_implemented("std::strong_ordering big_int::operator<=>(const big_int &) const noexcept", "your code should be here...");
+    if (_sign != other._sign)
+        return _sign ? std::strong_ordering::greater : std::strong_ordering::less;
+
+    int cmp = limbs_compare(_digits.data(), _digits.size(), other._digits.data(), other._digits.size());
+
+    if (!_sign)
+        cmp = -cmp;
+
+    return cmp <=> 0;
+}
+
+big_int::operator bool() const noexcept
+{
+    return !_digits.empty();
+}
+
+big_int &big_int::operator++() &
+{
+    return *this += big_int(1, _digits.get_allocator());
+}
+
+
+big_int big_int::operator++(int)
+{
+    big_int tmp(*this);
+    ++*this;
+    return tmp;
+}
+
+big_int &big_int::operator--() &
+{
+    return *this -= big_int(1, _digits.get_allocator());
+}
+
+
+big_int big_int::operator--(int)
+{
+    big_int tmp(*this);
+    --*this;
+    return tmp;
+}
+
+big_int &big_int::operator+=(const big_int &other) &
+{
+    return plus_assign(other);
+}
+
+big_int &big_int::operator-=(const big_int &other) &
+{
+    return minus_assign(other);
+}
+
+big_int big_int::operator+(const big_int &other) const &
+{
+    big_int tmp(*this);
+    return tmp += other;
+}
+
+big_int big_int::operator+(const big_int &other) &&
+{
+    return std::move(*this += other);
+}
+
+big_int big_int::operator+(big_int &&other) const &
+{
+    return std::move(other += *this);
+}
+
+big_int big_int::operator+(big_int &&other) &&
+{
+    return std::move(*this += other);
+}
+
+big_int big_int::operator-(const big_int &other) const &
+{
+    big_int tmp(*this);
+    return tmp -= other;
+}
+
+big_int big_int::operator-(const big_int &other) &&
+{
+    return std::move(*this -= other);
+}
+
+big_int big_int::operator-(big_int &&other) const &
+{
+    other -= *this;
+    other._sign = !other._sign;
+    other.optimise();
+    return std::move(other);
+}
+
+big_int big_int::operator-(big_int &&other) &&
+{
+    return std::move(*this -= other);
+}
+
+big_int big_int::operator*(const big_int &other) const &
+{
+    big_int tmp(*this);
+    return tmp *= other;
+}
+
+big_int big_int::operator*(const big_int &other) &&
+{
+    return std::move(*this *= other);
+}
+
+big_int big_int::operator*(big_int &&other) const &
+{
+    return std::move(other *= *this);
+}
+
+big_int big_int::operator*(big_int &&other) &&
+{
+    return std::move(*this *= other);
+}
+
+big_int big_int::operator/(const big_int &other) const &
+{
+    big_int tmp(*this);
+    return tmp /= other;
+}
+
+big_int big_int::operator/(const big_int &other) &&
+{
+    return std::move(*this /= other);
+}
+
+big_int big_int::operator%(const big_int &other) const &
+{
+    big_int tmp(*this);
+    return tmp %= other;
+}
+
+big_int big_int::operator%(const big_int &other) &&
+{
+    return std::move(*this %= other);
+}
+
+big_int big_int::operator&(const big_int &other) const &
+{
+    big_int tmp(*this);
+    return tmp &= other;
+}
+
+big_int big_int::operator&(const big_int &other) &&
+{
+    return std::move(*this &= other);
+}
+
+big_int big_int::operator|(const big_int &other) const &
+{
+    big_int tmp(*this);
+    return tmp |= other;
+}
+
+big_int big_int::operator|(const big_int &other) &&
+{
+    return std::move(*this |= other);
+}
+
+big_int big_int::operator^(const big_int &other) const &
+{
+    big_int tmp(*this);
+    return tmp ^= other;
+}
+
+big_int big_int::operator^(const big_int &other) &&
+{
+    return std::move(*this ^= other);
+}
+
+big_int big_int::operator<<(size_t shift) const &
+{
+    big_int tmp(*this);
+    return tmp <<= shift;
+}
+
+big_int big_int::operator<<(size_t shift) &&
+{
+    return std::move(*this <<= shift);
+}
+
+big_int big_int::operator>>(size_t shift) const &
+{
+    big_int tmp(*this);
+    return tmp >>= shift;
+}
+
+big_int big_int::operator>>(size_t shift) &&
+{
+    return std::move(*this >>= shift);
+}
+
+big_int &big_int::operator%=(const big_int &other) &
+{
+    return modulo_assign(other, decide_div(other._digits.size()));
+}
+
+big_int big_int::operator~() const &
+{
+    big_int tmp(*this);
+    return ~std::move(tmp);
+}
+
+big_int big_int::operator~() &&
+{
+    _sign = !_sign;
+    return std::move(--*this);
+}
+
+big_int &big_int::operator&=(const big_int &other) &
+{
+    size_t n = std::max(_digits.size(), other._digits.size()) + 1;
+
+    auto lhs = to_twos_complement(_sign, _digits, n);
+    auto rhs = to_twos_complement(other._sign, other._digits, n);
+
+    for (size_t i = 0; i < n; ++i)
+        lhs[i] &= rhs[i];
+
+    _sign = from_twos_complement(lhs);
+    _digits = std::move(lhs);
+    optimise();
+    return *this;
+}
+
+big_int &big_int::operator|=(const big_int &other) &
+{
+    size_t n = std::max(_digits.size(), other._digits.size()) + 1;
+
+    auto lhs = to_twos_complement(_sign, _digits, n);
+    auto rhs = to_twos_complement(other._sign, other._digits, n);
+
+    for (size_t i = 0; i < n; ++i)
+        lhs[i] |= rhs[i];
+
+    _sign = from_twos_complement(lhs);
+    _digits = std::move(lhs);
+    optimise();
+    return *this;
+}
+
+big_int &big_int::operator^=(const big_int &other) &
+{
+    size_t n = std::max(_digits.size(), other._digits.size()) + 1;
+
+    auto lhs = to_twos_complement(_sign, _digits, n);
+    auto rhs = to_twos_complement(other._sign, other._digits, n);
+
+    for (size_t i = 0; i < n; ++i)
+        lhs[i] ^= rhs[i];
+
+    _sign = from_twos_complement(lhs);
+    _digits = std::move(lhs);
+    optimise();
+    return *this;
+}
+
+big_int &big_int::operator<<=(size_t shift) &
+{
+    if (_digits.empty() || shift == 0)
+        return *this;
+
+    size_t limb_shift = shift / limb_bits;
+    unsigned bit_shift = shift % limb_bits;
+    size_t n = _digits.size();
+
+    _digits.resize(n + limb_shift + 1, 0);
+
+    if (bit_shift != 0)
+        _digits[n] = limbs_lshift(_digits.data(), _digits.data(), n, bit_shift);
+
+    if (limb_shift != 0)
+    {
+        std::copy_backward(_digits.begin(), _digits.begin() + n + 1, _digits.begin() + n + 1 + limb_shift);
+        std::fill(_digits.begin(), _digits.begin() + limb_shift, 0);
+    }
+
+    optimise();
+    return *this;
+}
+
+big_int &big_int::operator>>=(size_t shift) &
+{
+    if (_digits.empty() || shift == 0)
+        return *this;
+
+    size_t limb_shift = shift / limb_bits;
+    unsigned bit_shift = shift % limb_bits;
+
+    if (limb_shift >= _digits.size())
+    {
+        bool negative = !_sign;
+        _digits.clear();
+        optimise();
+        return negative ? (*this = big_int(-1, _digits.get_allocator())) : *this;
+    }
+
+    bool negative = !_sign;
+    bool lost = std::any_of(_digits.begin(), _digits.begin() + limb_shift, [](limb d) { return d != 0; });
+
+    _digits.erase(_digits.begin(), _digits.begin() + limb_shift);
+
+    if (bit_shift != 0)
+        lost |= limbs_rshift(_digits.data(), _digits.data(), _digits.size(), bit_shift) != 0;
+
+    // floor semantics for negative numbers
+    if (negative && lost)
+    {
+        _digits.push_back(0);
+        limbs_add_1(_digits.data(), _digits.data(), _digits.size(), 1);
+    }
+
+    optimise();
+    return *this;
+}
+
+big_int &big_int::plus_assign_signed(const big_int &other, bool other_sign, size_t shift) &
+{
+    if (this == &other)
+    {
+        big_int tmp(other);
+        return plus_assign_limbs(tmp._digits.data(), tmp._digits.size(), other_sign, shift);
+    }
+
+    return plus_assign_limbs(other._digits.data(), other._digits.size(), other_sign, shift);
+}
+
+big_int &big_int::plus_assign_limbs(const limb *limbs, size_t n, bool sign, size_t shift) &
+{
+    if (n == 0)
+        return *this;
+
+    if (_digits.empty())
+    {
+        _digits.assign(n + shift, 0);
+        std::copy(limbs, limbs + n, _digits.begin() + shift);
+        _sign = sign;
+        return *this;
+    }
+
+    if (_sign == sign)
+    {
+        size_t size = std::max(_digits.size(), n + shift) + 1;
+        _digits.resize(size, 0);
+        limbs_add(_digits.data() + shift, _digits.data() + shift, size - shift, limbs, n);
+        optimise();
+        return *this;
+    }
+
+    // signs differ, compare |this| with |limbs| * B^shift
+    int cmp;
+
+    if (_digits.size() != n + shift)
+    {
+        cmp = _digits.size() < n + shift ? -1 : 1;
+    } else
+    {
+        cmp = limbs_compare(_digits.data() + shift, n, limbs, n);
+
+        if (cmp == 0 && std::any_of(_digits.begin(), _digits.begin() + shift, [](limb d) { return d != 0; }))
+            cmp = 1;
+    }
+
+    if (cmp == 0)
+    {
+        _digits.clear();
+    } else if (cmp > 0)
+    {
+        limbs_sub(_digits.data() + shift, _digits.data() + shift, _digits.size() - shift, limbs, n);
+    } else
+    {
+        // |limbs| * B^shift - |this| in place, shifted operand has zeros below shift
+        _digits.resize(n + shift, 0);
+
+        limb borrow = 0;
+
+        for (size_t i = 0; i < shift; ++i)
+            _digits[i] = __detail::sub_with_borrow(0, _digits[i], borrow);
+        for (size_t i = shift; i < n + shift; ++i)
+            _digits[i] = __detail::sub_with_borrow(limbs[i - shift], _digits[i], borrow);
+
+        _sign = sign;
+    }
+
+    optimise();
+    return *this;
+}
+
+big_int &big_int::addmul_signed(const big_int &lhs, const big_int &rhs, bool product_sign) &
+{
+    if (lhs._digits.empty() || rhs._digits.empty())
+        return *this;
+
+    const big_int *longer = &lhs, *shorter = &rhs;
+
+    if (longer->_digits.size() < shorter->_digits.size())
+        std::swap(longer, shorter);
+
+    size_t ln = longer->_digits.size(), sn = shorter->_digits.size();
+
+    if (sn < karatsuba_cutoff() && longer != this && shorter != this)
+    {
+        // schoolbook rows are accumulated straight into this. When magnitudes are subtracted and the product
+        // is the larger one, the window wraps around exactly once and is negated at the end
+        bool add = _digits.empty() || _sign == product_sign;
+        size_t size = std::max(_digits.size(), ln + sn) + 1;
+        limb wrapped = 0;
+
+        if (_digits.empty())
+            _sign = product_sign;
+
+        _digits.resize(size, 0);
+        limb *r = _digits.data();
+
+        for (size_t i = 0; i < sn; ++i)
+        {
+            if (add)
+            {
+                limb carry = limbs_addmul_1(r + i, longer->_digits.data(), ln, shorter->_digits[i]);
+                limbs_add_1(r + i + ln, r + i + ln, size - i - ln, carry);
+            } else
+            {
+                limb borrow = limbs_submul_1(r + i, longer->_digits.data(), ln, shorter->_digits[i]);
+                wrapped |= limbs_sub_1(r + i + ln, r + i + ln, size - i - ln, borrow);
+            }
+        }
+
+        if (wrapped != 0)
+        {
+            for (size_t i = 0; i < size; ++i)
+                r[i] = ~r[i];
+            limbs_add_1(r, r, size, 1);
+            _sign = product_sign;
+        }
+
+        optimise();
+        return *this;
+    }
+
+    limb_vector product(ln + sn, 0, _digits.get_allocator());
+    multiply_magnitudes(product.data(), longer->_digits.data(), ln, shorter->_digits.data(), sn,
+                        longer->decide_mult(sn), 0, _digits.get_allocator());
+    strip_zeros(product);
+
+    return plus_assign_limbs(product.data(), product.size(), product_sign, 0);
+}
+
+big_int &big_int::addmul(const big_int &lhs, const big_int &rhs) &
+{
+    return addmul_signed(lhs, rhs, lhs._sign == rhs._sign);
+}
+
+big_int &big_int::submul(const big_int &lhs, const big_int &rhs) &
+{
+    return addmul_signed(lhs, rhs, lhs._sign != rhs._sign);
+}
+
+big_int &big_int::mul_add_assign(const big_int &multiplier, const big_int &addend) &
+{
+    if (&addend == this)
+    {
+        big_int tmp(addend);
+        return mul_add_assign(multiplier, tmp);
+    }
+
+    *this *= multiplier;
+    return plus_assign(addend);
+}
+
+void big_int::divmod(const big_int &dividend, const big_int &d, big_int &quotient, big_int &remainder)
+{
+    divmod(dividend, d, quotient, remainder, dividend.decide_div(d._digits.size()));
+}
+
+void big_int::divmod(const big_int &dividend, const big_int &d, big_int &quotient, big_int &remainder, big_int::division_rule rule, size_t threads)
+{
+    if (d._digits.empty())
+        throw std::logic_error("big_int: division by zero");
+
+    if (&quotient == &remainder)
+        throw std::invalid_argument("big_int: quotient and remainder must be different objects");
+
+    if (threads == 0)
+        threads = parallelism;
+
+    bool quotient_sign = dividend._sign == d._sign, remainder_sign = dividend._sign;
+
+    divide_magnitudes(dividend._digits, d._digits, &quotient._digits, &remainder._digits, rule, threads);
+
+    quotient._sign = quotient_sign;
+    quotient.optimise();
+    remainder._sign = remainder_sign;
+    remainder.optimise();
+}
+
+big_int::product_expression::product_expression(const big_int &lhs, const big_int &rhs) noexcept : _lhs(lhs), _rhs(rhs) {}
+
+big_int::product_expression::operator big_int() const
+{
+    big_int res(_lhs._digits.get_allocator());
+    res = *this;
+    return res;
+}
+
+big_int::product_expression big_int::product(const big_int &lhs, const big_int &rhs) noexcept
+{
+    return {lhs, rhs};
+}
+
+big_int &big_int::operator=(const big_int::product_expression &expression) &
+{
+    const big_int &lhs = expression._lhs, &rhs = expression._rhs;
+
+    if (this == &lhs)
+        return *this *= rhs;
+    if (this == &rhs)
+        return *this *= lhs;
+
+    size_t an = lhs._digits.size(), bn = rhs._digits.size();
+
+    if (an == 0 || bn == 0)
+    {
+        _digits.clear();
+        optimise();
+        return *this;
+    }
+
+    _digits.assign(an + bn, 0);
+    multiply_magnitudes(_digits.data(), lhs._digits.data(), an, rhs._digits.data(), bn, lhs.decide_mult(bn), 0, _digits.get_allocator());
+
+    _sign = lhs._sign == rhs._sign;
+    optimise();
+    return *this;
+}
+
+big_int &big_int::operator+=(const big_int::product_expression &expression) &
+{
+    return addmul(expression._lhs, expression._rhs);
+}
+
+big_int &big_int::operator-=(const big_int::product_expression &expression) &
+{
+    return submul(expression._lhs, expression._rhs);
+}
+
+big_int &big_int::plus_assign(const big_int &other, size_t shift) &
+{
+    return plus_assign_signed(other, other._sign, shift);
+}
+
+big_int &big_int::minus_assign(const big_int &other, size_t shift) &
+{
+    return plus_assign_signed(other, !other._sign, shift);
+}
+
+big_int &big_int::operator*=(const big_int &other) &
+{
+    return multiply_assign(other, decide_mult(other._digits.size()));
+}
+
+big_int &big_int::operator/=(const big_int &other) &
+{
+    return divide_assign(other, decide_div(other._digits.size()));
+}
+
+std::string big_int::to_string(unsigned int radix) const
+{
+    if (radix < 2 || radix > 36)
+        throw std::invalid_argument("big_int: radix must be in [2, 36]");
+
+    std::string digits = limbs_to_string(_digits, radix);
+    return _sign ? digits : "-" + digits;
+}
+
+size_t big_int::export_size() const noexcept
+{
+    if (_digits.empty())
+        return 0;
+
+    return (_digits.size() - 1) * sizeof(limb) + (std::bit_width(_digits.back()) + 7) / 8;
+}
+
+void big_int::export_limbs(std::span<std::byte> bytes, std::endian order) const
+{
+    size_t size = export_size();
+
+    if (bytes.size() < size)
+        throw std::invalid_argument("big_int: buffer is too short for export");
+
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        if (size != 0)
+            std::memcpy(bytes.data(), _digits.data(), size);
+    }
+    else
+    {
+        for (size_t i = 0; i < size; ++i)
+            bytes[i] = static_cast<std::byte>(_digits[i / sizeof(limb)] >> (8 * (i % sizeof(limb))));
+    }
+
+    std::fill(bytes.begin() + size, bytes.end(), std::byte{0});
+
+    if (order == std::endian::big)
+        std::reverse(bytes.begin(), bytes.end());
+}
+
+big_int& big_int::import_limbs(std::span<const std::byte> bytes, std::endian order, bool sign) &
+{
+    size_t size = bytes.size();
+    limb_vector res((size + sizeof(limb) - 1) / sizeof(limb), 0, _digits.get_allocator());
+
+    if (std::endian::native == std::endian::little && order == std::endian::little)
+    {
+        if (size != 0)
+            std::memcpy(res.data(), bytes.data(), size);
+    }
+    else
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto byte = order == std::endian::little ? bytes[i] : bytes[size - 1 - i];
+            res[i / sizeof(limb)] |= static_cast<limb>(byte) << (8 * (i % sizeof(limb)));
+        }
+    }
+
+    strip_zeros(res);
+    _digits = std::move(res);
+    _sign = sign || _digits.empty();
+    return *this;
+}
+
+void big_int::write_binary(std::ostream &stream) const
+{
+    size_t size = export_size();
+    unsigned long long header = static_cast<unsigned long long>(size) << 1 | (_sign ? 0 : 1);
+
+    do
+    {
+        stream.put(static_cast<char>((header & 0x7f) | (header >= 0x80 ? 0x80 : 0)));
+        header >>= 7;
+    } while (header != 0);
+
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        stream.write(reinterpret_cast<const char *>(_digits.data()), static_cast<std::streamsize>(size));
+    }
+    else
+    {
+        std::vector<std::byte> bytes(size);
+        export_limbs(bytes);
+        stream.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(size));
+    }
+}
+
+big_int& big_int::read_binary(std::istream &stream) &
+{
+    std::istream::sentry sentry(stream, true);
+
+    if (!sentry)
+        return *this;
+
+    auto *buffer = stream.rdbuf();
+    auto eof = std::char_traits<char>::eof();
+    unsigned long long header = 0;
+    int ch;
+
+    for (unsigned int shift = 0;; shift += 7)
+    {
+        ch = buffer->sbumpc();
+
+        if (ch == eof || shift > 63 || (shift == 63 && (ch & 0x7e) != 0))
+        {
+            stream.setstate(ch == eof ? std::ios_base::eofbit | std::ios_base::failbit : std::ios_base::failbit);
+            return *this;
+        }
+
+        header |= static_cast<unsigned long long>(ch & 0x7f) << shift;
+
+        if (!(ch & 0x80))
+            break;
+    }
+
+    unsigned long long size = header >> 1;
+    bool sign = !(header & 1);
+
+    if (!sign && size == 0)
+    {
+        stream.setstate(std::ios_base::failbit);
+        return *this;
+    }
+
+    // bytes go straight into limbs in bounded pieces, so a corrupt length fails on end of stream instead of a huge allocation
+    constexpr size_t piece = size_t(1) << 20;
+    limb_vector res(_digits.get_allocator());
+
+    for (unsigned long long done = 0; done < size;)
+    {
+        size_t count = std::min<unsigned long long>(piece, size - done);
+        res.resize((done + count + sizeof(limb) - 1) / sizeof(limb), 0);
+
+        auto read = buffer->sgetn(reinterpret_cast<char *>(res.data()) + done, static_cast<std::streamsize>(count));
+
+        if (static_cast<size_t>(read) != count)
+        {
+            stream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+            return *this;
+        }
+
+        done += count;
+    }
+
+    if constexpr (std::endian::native != std::endian::little)
+    {
+        for (auto &digit : res)
+            digit = std::byteswap(digit);
+    }
+
+    strip_zeros(res);
+    _digits = std::move(res);
+    _sign = sign || _digits.empty();
+    return *this;
+}
+
+std::ostream &operator<<(std::ostream &stream, const big_int &value)
+{
+    auto base = stream.flags() & std::ios_base::basefield;
+    return stream << value.to_string(base == std::ios_base::hex ? 16 : base == std::ios_base::oct ? 8 : 10);
+}
+
+std::istream &operator>>(std::istream &stream, big_int &value)
+{
+    std::istream::sentry sentry(stream);
+
+    if (!sentry)
+        return stream;
+
+    auto base = stream.flags() & std::ios_base::basefield;
+    unsigned int radix = base == std::ios_base::hex ? 16 : base == std::ios_base::oct ? 8 : 10;
+    auto [chunk, chunk_digits] = radix_chunk(radix);
+    auto allocator = value._digits.get_allocator();
+
+    // digits are parsed in blocks as they arrive; finished blocks are merged like a binary counter,
+    // so text in memory never exceeds one block and merges use powers of the cached tree
+    constexpr size_t block_level = 12;
+    size_t block_digits = chunk_digits << block_level;
+
+    std::vector<std::pair<limb_vector, size_t>> blocks; // value and level, levels strictly decrease
+    std::string block;
+    block.reserve(block_digits);
+
+    auto *buffer = stream.rdbuf();
+    auto eof = std::char_traits<char>::eof();
+    bool sign = true, any = false;
+
+    int ch = buffer->sgetc();
+
+    if (ch == '-' || ch == '+')
+    {
+        sign = ch == '+';
+        ch = buffer->snextc();
+    }
+
+    for (; ch != eof; ch = buffer->snextc())
+    {
+        int digit = char_to_digit(static_cast<char>(ch));
+
+        if (digit < 0 || static_cast<unsigned int>(digit) >= radix)
+            break;
+
+        any = true;
+        block.push_back(static_cast<char>(ch));
+
+        if (block.size() < block_digits)
+            continue;
+
+        blocks.emplace_back(limbs_from_radix(block.data(), block.size(), radix, allocator), 0);
+        block.clear();
+
+        while (blocks.size() > 1 && blocks[blocks.size() - 2].second == blocks.back().second)
+        {
+            auto power = radix_power_level(radix, block_level + blocks.back().second);
+            auto [lo, level] = std::move(blocks.back());
+            blocks.pop_back();
+
+            blocks.back().first = limbs_mul_add(blocks.back().first, power->value.data(), power->value.size(), lo);
+            blocks.back().second = level + 1;
+        }
+    }
+
+    if (ch == eof)
+        stream.setstate(std::ios_base::eofbit);
+
+    if (!any)
+    {
+        stream.setstate(std::ios_base::failbit);
+        return stream;
+    }
+
+    limb_vector res(allocator);
+
+    for (auto &[part, level] : blocks)
+    {
+        auto power = radix_power_level(radix, block_level + level);
+        res = limbs_mul_add(res, power->value.data(), power->value.size(), part);
+    }
+
+    // radix^len for the tail from powers of the tree and one limb
+    size_t chunks = block.size() / chunk_digits;
+    limb_vector tail_power(1, 1, allocator);
+
+    for (size_t i = 0; i < block.size() % chunk_digits; ++i)
+        tail_power[0] *= radix;
+
+    for (size_t k = 0; chunks >> k != 0; ++k)
+    {
+        if (!((chunks >> k) & 1))
+            continue;
+
+        auto power = radix_power_level(radix, k);
+        limb_vector product(tail_power.size() + power->value.size(), 0, allocator);
+        limbs_mul(product.data(), tail_power.data(), tail_power.size(), power->value.data(), power->value.size(), allocator);
+        strip_zeros(product);
+        tail_power = std::move(product);
+    }
+
+    res = limbs_mul_add(res, tail_power.data(), tail_power.size(), limbs_from_radix(block.data(), block.size(), radix, allocator));
+
+    value._digits = std::move(res);
+    value._sign = sign;
+    value.optimise();
+    return stream;
+}
+
+bool big_int::operator==(const big_int &other) const noexcept
+{
+    return _sign == other._sign && _digits.size() == other._digits.size() && std::equal(_digits.begin(), _digits.end(), other._digits.begin());
+}
+
+big_int::big_int(const std::vector<unsigned int, pp_allocator<unsigned int>> &digits, bool sign) : big_int(digits, sign, pp_allocator<value_type>(digits.get_allocator())) {}
+
+big_int::big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits, bool sign) : big_int(digits, sign, pp_allocator<value_type>(digits.get_allocator())) {}
+
+big_int::big_int(const std::string &num, unsigned int radix, pp_allocator<value_type> allocator) : _sign(true), _digits(allocator)
+{
+    if (radix < 2 || radix > 36)
+        throw std::invalid_argument("big_int: radix must be in [2, 36]");
+
+    size_t pos = 0;
+
+    if (pos < num.size() && (num[pos] == '-' || num[pos] == '+'))
+    {
+        _sign = num[pos] == '+';
+        ++pos;
+    }
+
+    if (pos == num.size())
+        throw std::invalid_argument("big_int: empty number string");
+
+    _digits = limbs_from_radix(num.data() + pos, num.size() - pos, radix, allocator);
+    optimise();
+}
+
+big_int::big_int(pp_allocator<value_type> allocator) : _sign(true), _digits(allocator) {}
+
+void big_int::set_thread_pool_size(size_t threads)
+{
+    std::lock_guard lock(thread_pool_mutex);
+    thread_pool_size = threads;
+    thread_pool_instance.reset(); // running sections keep the old pool alive until they finish
+}
+
+namespace
+{
+    const std::array<std::pair<const char *, size_t *>, 9> &tuning_parameters() noexcept
+    {
+        static const std::array<std::pair<const char *, size_t *>, 9> parameters
+        {{
+            {"karatsuba_threshold", &big_int::karatsuba_threshold},
+            {"karatsuba_square_threshold", &big_int::karatsuba_square_threshold},
+            {"toom3_threshold", &big_int::toom3_threshold},
+            {"toom4_threshold", &big_int::toom4_threshold},
+            {"ntt_threshold", &big_int::ntt_threshold},
+            {"burnikel_ziegler_threshold", &big_int::burnikel_ziegler_threshold},
+            {"newton_threshold", &big_int::newton_threshold},
+            {"hgcd_threshold", &big_int::hgcd_threshold},
+            {"parallel_threshold", &big_int::parallel_threshold}
+        }};
+
+        return parameters;
+    }
+}
+
+void big_int::load_tuning(std::istream &stream)
+{
+    std::string line;
+    std::vector<std::pair<size_t *, size_t>> values; // applied only when whole table is valid
+
+    while (std::getline(stream, line))
+    {
+        std::istringstream fields(line.substr(0, line.find('#')));
+        std::string name, rest;
+        long long value;
+
+        if (!(fields >> name))
+            continue;
+
+        if (!(fields >> value) || value < 0 || fields >> rest)
+            throw std::invalid_argument("big_int: malformed tuning line \"" + line + "\"");
+
+        auto &parameters = tuning_parameters();
+        auto it = std::ranges::find_if(parameters, [&](const auto &parameter) { return name == parameter.first; });
+
+        if (it == parameters.end())
+            throw std::invalid_argument("big_int: unknown tuning parameter \"" + name + "\"");
+
+        values.emplace_back(it->second, static_cast<size_t>(value));
+    }
+
+    for (auto [parameter, value] : values)
+        *parameter = value;
+}
+
+void big_int::load_tuning(const std::string &path)
+{
+    std::ifstream stream(path);
+
+    if (!stream)
+        throw std::runtime_error("big_int: cannot open tuning file " + path);
+
+    load_tuning(stream);
+}
+
+void big_int::save_tuning(std::ostream &stream)
+{
+    for (auto &[name, value] : tuning_parameters())
+        stream << name << ' ' << *value << '\n';
+}
+
+big_int &big_int::multiply_assign(const big_int &other, big_int::multiplication_rule rule, size_t threads) &
+{
+    if (_digits.empty() || other._digits.empty())
+    {
+        _digits.clear();
+        optimise();
+        return *this;
+    }
+
+    size_t an = _digits.size(), bn = other._digits.size();
+    _sign = _sign == other._sign;
+
+    if (bn == 1 || an == 1)
+    {
+        // single limb factor is multiplied in place
+        limb factor = bn == 1 ? other._digits[0] : _digits[0];
+        size_t n = bn == 1 ? an : bn;
+
+        if (an == 1)
+            _digits.resize(n);
+        if (an == 1 && bn != 1)
+            std::copy(other._digits.begin(), other._digits.end(), _digits.begin());
+
+        _digits.push_back(limbs_mul_1(_digits.data(), _digits.data(), n, factor));
+        optimise();
+        return *this;
+    }
+
+    const limb *b = this == &other || (an == bn && std::equal(_digits.begin(), _digits.end(), other._digits.begin()))
+                    ? _digits.data() : other._digits.data();
+
+    limb_vector res(an + bn, 0, _digits.get_allocator());
+    multiply_magnitudes(res.data(), _digits.data(), an, b, bn, rule, threads, _digits.get_allocator());
+
+    _digits = std::move(res);
+    optimise();
+    return *this;
+}
+
+big_int &big_int::divide_assign(const big_int &other, big_int::division_rule rule, size_t threads) &
+{
+    if (other._digits.empty())
+        throw std::logic_error("big_int: division by zero");
+
+    if (threads == 0)
+        threads = parallelism;
+
+    switch (rule)
+    {
+        case division_rule::trivial:
+        case division_rule::Newton:
+        case division_rule::BurnikelZiegler:
+            divide_magnitudes(_digits, other._digits, &_digits, nullptr, rule, threads);
+            break;
+    }
+
+    _sign = _sign == other._sign;
+    optimise();
+    return *this;
+}
+
+big_int &big_int::modulo_assign(const big_int &other, big_int::division_rule rule, size_t threads) &
+{
+    if (other._digits.empty())
+        throw std::logic_error("big_int: division by zero");
+
+    if (threads == 0)
+        threads = parallelism;
+
+    switch (rule)
+    {
+        case division_rule::trivial:
+        case division_rule::Newton:
+        case division_rule::BurnikelZiegler:
+            divide_magnitudes(_digits, other._digits, nullptr, &_digits, rule, threads);
+            break;
+    }
+
+    optimise();
+    return *this;
+}
+
+big_int &big_int::divexact_assign(const big_int &other) &
+{
+    if (other._digits.empty())
+        throw std::logic_error("big_int: division by zero");
+
+    if (this == &other)
+    {
+        _digits.assign(1, 1);
+        _sign = true;
+        return *this;
+    }
+
+    _sign = _sign == other._sign;
+
+    // d = d' * 2^k with odd d', exact quotient stays the same when both are shifted by k
+    auto allocator = _digits.get_allocator();
+    size_t zero_limbs = 0;
+
+    while (other._digits[zero_limbs] == 0)
+        ++zero_limbs;
+
+    unsigned zero_bits = std::countr_zero(other._digits[zero_limbs]);
+    limb_vector shifted(allocator);
+    const limb *d = other._digits.data();
+    size_t dn = other._digits.size();
+
+    if (zero_limbs != 0 || zero_bits != 0)
+    {
+        shifted.assign(other._digits.begin() + zero_limbs, other._digits.end());
+        _digits.erase(_digits.begin(), _digits.begin() + std::min(zero_limbs, _digits.size()));
+
+        if (zero_bits != 0)
+        {
+            limbs_rshift(shifted.data(), shifted.data(), shifted.size(), zero_bits);
+            if (!_digits.empty())
+                limbs_rshift(_digits.data(), _digits.data(), _digits.size(), zero_bits);
+        }
+
+        strip_zeros(shifted);
+        strip_zeros(_digits);
+
+        d = shifted.data();
+        dn = shifted.size();
+    }
+
+    size_t an = _digits.size();
+
+    if (an < dn)
+    {
+        _digits.clear();
+    } else if (dn == 1)
+    {
+        limbs_divexact_1(_digits.data(), _digits.data(), an, d[0]);
+    } else
+    {
+        // quotient is below B^qn, so it equals quotient modulo B^qn
+        size_t qn = an - dn + 1;
+        limb_vector q(qn, 0, allocator);
+
+        _digits.push_back(0);
+        limbs_bdiv_qr(q.data(), _digits.data(), qn, d, dn, limb_inverse_2adic(d[0]), allocator);
+        _digits = std::move(q);
+    }
+
+    optimise();
+    return *this;
+}
+
+big_int big_int::divexact(const big_int &other) const
+{
+    big_int tmp(*this);
+    return tmp.divexact_assign(other);
+}
+
+big_int::divisor::divisor(const big_int &value) : _value(value), _shift(0), _normalised(value._digits.get_allocator()), _reciprocal(value._digits.get_allocator())
+{
+    if (value._digits.empty())
+        throw std::logic_error("big_int: division by zero");
+
+    size_t n = value._digits.size();
+    _shift = std::countl_zero(value._digits.back());
+    _normalised.resize(n);
+
+    if (_shift != 0)
+        limbs_lshift(_normalised.data(), value._digits.data(), n, _shift);
+    else
+        _normalised = value._digits;
+
+    if (n >= newton_threshold)
+    {
+        _reciprocal.resize(n + 1);
+        limbs_reciprocal(_reciprocal.data(), _normalised.data(), n, _normalised.get_allocator());
+    }
+}
+
+const big_int &big_int::divisor::value() const noexcept
+{
+    return _value;
+}
+
+void big_int::divisor::divide(const big_int &dividend, big_int *quotient, big_int *remainder) const
+{
+    const limb_vector &a = dividend._digits;
+    size_t an = a.size(), n = _normalised.size();
+    auto allocator = a.get_allocator();
+
+    if (limbs_compare(a.data(), an, _value._digits.data(), n) < 0)
+    {
+        if (remainder != nullptr)
+            *remainder = dividend;
+        if (quotient != nullptr)
+            *quotient = big_int(allocator);
+        return;
+    }
+
+    limb_vector un(an + 1, 0, allocator), q(an + 1 - n, 0, allocator);
+
+    if (_shift != 0)
+        un[an] = limbs_lshift(un.data(), a.data(), an, _shift);
+    else
+        std::copy(a.begin(), a.end(), un.begin());
+
+    if (_reciprocal.empty())
+        limbs_div_schoolbook(q.data(), un.data(), an + 1, _normalised.data(), n);
+    else
+        limbs_div_barrett(q.data(), un.data(), an + 1, _normalised.data(), n, _reciprocal.data(), allocator);
+
+    if (remainder != nullptr)
+    {
+        un.resize(n);
+        if (_shift != 0)
+            limbs_rshift(un.data(), un.data(), n, _shift);
+
+        remainder->_digits = std::move(un);
+        remainder->_sign = dividend._sign;
+        remainder->optimise();
+    }
+
+    if (quotient != nullptr)
+    {
+        quotient->_digits = std::move(q);
+        quotient->_sign = dividend._sign == _value._sign;
+        quotient->optimise();
+    }
+}
+
+big_int big_int::divisor::div(const big_int &dividend) const
+{
+    big_int quotient(dividend._digits.get_allocator());
+    divide(dividend, &quotient, nullptr);
+    return quotient;
+}
+
+big_int big_int::divisor::mod(const big_int &dividend) const
+{
+    big_int remainder(dividend._digits.get_allocator());
+    divide(dividend, nullptr, &remainder);
+    return remainder;
+}
+
+std::pair<big_int, big_int> big_int::divisor::divmod(const big_int &dividend) const
+{
+    big_int quotient(dividend._digits.get_allocator()), remainder(dividend._digits.get_allocator());
+    divide(dividend, &quotient, &remainder);
+    return {std::move(quotient), std::move(remainder)};
+}
+
+namespace
+{
+    /** Window width for sliding window exponentiation by exponent length in bits
+     */
+    size_t exponentiation_window(size_t bits) noexcept
+    {
+        if (bits > 671)
+            return 6;
+        if (bits > 239)
+            return 5;
+        if (bits > 79)
+            return 4;
+        if (bits > 23)
+            return 3;
+        return bits > 7 ? 2 : 1;
+    }
+
+    /** Bits [pos, pos + count) of exponent, positions past the end read as zeros
+     */
+    size_t exponent_bits(const limb_vector &e, size_t pos, size_t count) noexcept
+    {
+        size_t res = 0;
+
+        for (size_t i = 0; i < count; ++i, ++pos)
+        {
+            if (pos / limb_bits < e.size())
+                res |= static_cast<size_t>((e[pos / limb_bits] >> (pos % limb_bits)) & 1) << i;
+        }
+
+        return res;
+    }
+
+    /** r = base^e * R mod m by sliding window for base_m = base * R mod m and nonzero e, r may be equal to base_m
+     */
+    void montgomery_pow(montgomery_context &context, limb *r, const limb *base_m, const limb_vector &e, pp_allocator<limb> allocator)
+    {
+        size_t n = context.size();
+        size_t bits = e.size() * limb_bits - std::countl_zero(e.back());
+        size_t w = exponentiation_window(bits);
+
+        // odd_powers[i] = base^(2i + 1) * R mod m
+        limb_vector odd_powers((size_t(1) << (w - 1)) * n, 0, allocator), base_squared(n, 0, allocator);
+        std::copy(base_m, base_m + n, odd_powers.begin());
+        context.sqr(base_squared.data(), odd_powers.data());
+
+        for (size_t i = 1; i < (size_t(1) << (w - 1)); ++i)
+            context.mul(odd_powers.data() + i * n, odd_powers.data() + (i - 1) * n, base_squared.data());
+
+        bool started = false;
+
+        for (size_t pos = bits; pos > 0;)
+        {
+            if (!((e[(pos - 1) / limb_bits] >> ((pos - 1) % limb_bits)) & 1))
+            {
+                context.sqr(r, r);
+                --pos;
+                continue;
+            }
+
+            size_t len = std::min(w, pos);
+            while (!exponent_bits(e, pos - len, 1))
+                --len;
+
+            const limb *power = odd_powers.data() + (exponent_bits(e, pos - len, len) >> 1) * n;
+
+            if (started)
+            {
+                for (size_t j = 0; j < len; ++j)
+                    context.sqr(r, r);
+
+                context.mul(r, r, power);
+            } else
+            {
+                std::copy(power, power + n, r);
+                started = true;
+            }
+
+            pos -= len;
+        }
+    }
+
+    void check_modulus(const big_int &modulus)
+    {
+        if (modulus <= big_int(0))
+            throw std::logic_error("big_int: modulus must be positive");
+    }
+
+    /** value mod modulus in [0, modulus)
+     */
+    big_int reduce(const big_int &value, const big_int &modulus)
+    {
+        big_int res = value % modulus;
+
+        if (res < big_int(0))
+            res += modulus;
+
+        return res;
+    }
+}
+
+big_int big_int::mul_mod(const big_int &other, const big_int &modulus) const
+{
+    check_modulus(modulus);
+
+    // a lone product does not amortise conversion to Montgomery form, one division is cheaper
+    return reduce(*this * other, modulus);
+}
+
+big_int big_int::inverse_mod(const big_int &modulus) const
+{
+    check_modulus(modulus);
+
+    big_int s, t;
+
+    if (xgcd(reduce(*this, modulus), modulus, s, t) != big_int(1))
+        throw std::logic_error("big_int: value is not invertible modulo modulus");
+
+    return reduce(s, modulus);
+}
+
+big_int big_int::pow_mod(const big_int &exponent, const big_int &modulus, bool constant_time) const
+{
+    check_modulus(modulus);
+
+    if (constant_time && (modulus._digits[0] & 1) == 0)
+        throw std::invalid_argument("big_int: constant time pow_mod requires odd modulus");
+
+    if (modulus == big_int(1))
+        return big_int(0, _digits.get_allocator());
+
+    big_int base = exponent._sign ? reduce(*this, modulus) : inverse_mod(modulus);
+    const limb_vector &e = exponent._digits;
+    size_t bits = e.empty() ? 0 : e.size() * limb_bits - std::countl_zero(e.back());
+    size_t n = modulus._digits.size();
+    auto allocator = _digits.get_allocator();
+
+    if (constant_time)
+    {
+        // fixed windows over every limb of exponent, each table entry is read on every lookup
+        size_t w = 4, windows = (e.size() * limb_bits + w - 1) / w;
+        montgomery_context context(modulus._digits.data(), n, true, allocator);
+
+        big_int r_squared = reduce(big_int(1, allocator) << (2 * n * limb_bits), modulus);
+        r_squared._digits.resize(n, 0);
+        base._digits.resize(n, 0);
+
+        limb_vector table((size_t(1) << w) * n, 0, allocator);
+        limb_vector acc(n, 0, allocator), entry(n, 0, allocator);
+
+        // table[0] = R mod m, table[1] = base * R mod m
+        acc[0] = 1;
+        context.mul(table.data(), acc.data(), r_squared._digits.data());
+        context.mul(table.data() + n, base._digits.data(), r_squared._digits.data());
+
+        for (size_t i = 2; i < (size_t(1) << w); ++i)
+            context.mul(table.data() + i * n, table.data() + (i - 1) * n, table.data() + n);
+
+        std::copy(table.begin(), table.begin() + n, acc.begin());
+
+        for (size_t i = windows; i-- > 0;)
+        {
+            for (size_t j = 0; j < w; ++j)
+                context.sqr(acc.data(), acc.data());
+
+            limb index = exponent_bits(e, i * w, w);
+            std::fill(entry.begin(), entry.end(), 0);
+
+            for (size_t j = 0; j < (size_t(1) << w); ++j)
+            {
+                limb diff = j ^ index;
+                limb mask = ((diff | (limb(0) - diff)) >> (limb_bits - 1)) - 1;
+
+                for (size_t k = 0; k < n; ++k)
+                    entry[k] |= table[j * n + k] & mask;
+            }
+
+            context.mul(acc.data(), acc.data(), entry.data());
+        }
+
+        std::fill(entry.begin(), entry.end(), 0);
+        entry[0] = 1;
+        context.mul(acc.data(), acc.data(), entry.data());
+
+        big_int res(allocator);
+        res._digits = std::move(acc);
+        res.optimise();
+        return res;
+    }
+
+    if (bits == 0)
+        return big_int(1, allocator);
+
+    size_t w = exponentiation_window(bits);
+
+    if ((modulus._digits[0] & 1) == 0)
+    {
+        // Montgomery needs odd modulus, reduce by precomputed reciprocal instead
+        divisor d(modulus);
+
+        std::vector<big_int> odd_powers(size_t(1) << (w - 1), base);
+        big_int base_squared = d.mod(base * base);
+
+        for (size_t i = 1; i < odd_powers.size(); ++i)
+            odd_powers[i] = d.mod(odd_powers[i - 1] * base_squared);
+
+        big_int acc(1, allocator);
+
+        for (size_t pos = bits; pos > 0;)
+        {
+            if (!((e[(pos - 1) / limb_bits] >> ((pos - 1) % limb_bits)) & 1))
+            {
+                acc = d.mod(acc * acc);
+                --pos;
+                continue;
+            }
+
+            // longest window ending with a set bit
+            size_t len = std::min(w, pos);
+            while (!exponent_bits(e, pos - len, 1))
+                --len;
+
+            for (size_t j = 0; j < len; ++j)
+                acc = d.mod(acc * acc);
+
+            acc = d.mod(acc * odd_powers[exponent_bits(e, pos - len, len) >> 1]);
+            pos -= len;
+        }
+
+        return acc;
+    }
+
+    montgomery_context context(modulus._digits.data(), n, false, allocator);
+
+    big_int r_squared = reduce(big_int(1, allocator) << (2 * n * limb_bits), modulus);
+    r_squared._digits.resize(n, 0);
+    base._digits.resize(n, 0);
+
+    limb_vector acc(n, 0, allocator);
+    context.mul(acc.data(), base._digits.data(), r_squared._digits.data());
+    montgomery_pow(context, acc.data(), acc.data(), e, allocator);
+
+    limb_vector one(n, 0, allocator);
+    one[0] = 1;
+    context.mul(acc.data(), acc.data(), one.data());
+
+    big_int res(allocator);
+    res._digits = std::move(acc);
+    res.optimise();
+    return res;
 }
 
-big_int::operator bool() const noexcept
-{
-    throw not_implemented("big_int::operator bool()", "your code should be here...");
-}
+namespace
+{
+    size_t limbs_normalised_size(const limb *a, size_t n) noexcept
+    {
+        while (n > 0 && a[n - 1] == 0)
+            --n;
+
+        return n;
+    }
+
+    /** Binary (Stein's) gcd of single limbs
+     */
+    limb gcd_1(limb a, limb b) noexcept
+    {
+        if (a == 0 || b == 0)
+            return a | b;
+
+        int shift = std::countr_zero(a | b);
+        a >>= std::countr_zero(a);
+
+        while (b != 0)
+        {
+            b >>= std::countr_zero(b);
+
+            if (a > b)
+                std::swap(a, b);
+
+            b -= a;
+        }
+
+        return a << shift;
+    }
+
+    /** Binary gcd of two-limb values, result replaces (a1, a0)
+     */
+    void gcd_2(limb &a1, limb &a0, limb b1, limb b0) noexcept
+    {
+        if ((a1 | a0) == 0 || (b1 | b0) == 0)
+        {
+            a1 |= b1;
+            a0 |= b0;
+            return;
+        }
+
+        auto trailing_zeros = [](limb hi, limb lo) -> unsigned
+        {
+            return lo != 0 ? std::countr_zero(lo) : limb_bits + std::countr_zero(hi);
+        };
+
+        auto shift_right = [](limb &hi, limb &lo, unsigned count)
+        {
+            if (count >= limb_bits)
+            {
+                lo = hi >> (count - limb_bits);
+                hi = 0;
+            } else if (count != 0)
+            {
+                lo = (lo >> count) | (hi << (limb_bits - count));
+                hi >>= count;
+            }
+        };
+
+        unsigned shift = std::min(trailing_zeros(a1, a0), trailing_zeros(b1, b0));
+        shift_right(a1, a0, trailing_zeros(a1, a0));
+
+        while ((a1 != 0 || b1 != 0) && (b1 | b0) != 0)
+        {
+            shift_right(b1, b0, trailing_zeros(b1, b0));
+
+            if (a1 > b1 || (a1 == b1 && a0 > b0))
+            {
+                std::swap(a1, b1);
+                std::swap(a0, b0);
+            }
+
+            b1 -= a1 + (b0 < a0);
+            b0 -= a0;
+        }
+
+        if (a1 == 0 && b1 == 0)
+            a0 = gcd_1(a0, b0);
+
+        if (shift >= limb_bits)
+        {
+            a1 = a0 << (shift - limb_bits);
+            a0 = 0;
+        } else if (shift != 0)
+        {
+            a1 = (a1 << shift) | (a0 >> (limb_bits - shift));
+            a0 <<= shift;
+        }
+    }
+
+    /** Euclid steps on single limbs, (a; b) = M (a'; b') with non-negative entries and determinant 1
+     */
+    struct gcd_matrix_1
+    {
+        limb u00, u01, u10, u11;
+    };
 
-big_int &big_int::operator++() &
-{
-    throw not_implemented("big_int &big_int::operator++()", "your code should be here...");
-}
+    constexpr limb lehmer_min_limit = limb(1) << 33;
 
+    /** Euclid steps on leading bits x and y of a and b taken at the same position, while both stay at least
+     *  limit >= 2^33. Entries of M are then below 2^31 and M^-1 applied to a and b themselves gives non-negative
+     *  values above (limit - 2^31) * 2^position (Jebelean's criterion). Returns false if no step was made
+     */
+    bool lehmer_matrix(limb x, limb y, limb limit, gcd_matrix_1 &m) noexcept
+    {
+        m = {1, 0, 0, 1};
 
-big_int big_int::operator++(int)
-{
-    throw not_implemented("big_int big_int::operator++(int)", "your code should be here...");
-}
+        if (x < limit || y < limit)
+            return false;
 
-big_int &big_int::operator--() &
-{
-    throw not_implemented("big_int &big_int::operator--()", "your code should be here...");
-}
+        bool progress = false;
 
+        for (;;)
+        {
+            bool reduce_x = x >= y;
+            limb &big = reduce_x ? x : y, small = reduce_x ? y : x;
+            limb q = big / small, r = big - q * small;
+            bool last = r < limit;
 
-big_int big_int::operator--(int)
-{
-    throw not_implemented("big_int big_int::operator--(int)", "your code should be here...");
-}
+            // stop one subtraction earlier, so that big stays above limit
+            if (last && --q == 0)
+                break;
+            if (last)
+                r += small;
 
-big_int &big_int::operator+=(const big_int &other) &
-{
-    throw not_implemented("big_int &big_int::operator+=(const big_int &)", "your code should be here...");
-}
+            big = r;
+            progress = true;
 
-big_int &big_int::operator-=(const big_int &other) &
-{
-    throw not_implemented("big_int &big_int::operator-=(const big_int &)", "your code should be here...");
-}
+            if (reduce_x)
+            {
+                m.u01 += q * m.u00;
+                m.u11 += q * m.u10;
+            } else
+            {
+                m.u00 += q * m.u01;
+                m.u10 += q * m.u11;
+            }
 
-big_int big_int::operator+(const big_int &other) const
-{
-    throw not_implemented("big_int big_int::operator+(const big_int &) const", "your code should be here...");
-}
+            if (last)
+                break;
+        }
 
-big_int big_int::operator-(const big_int &other) const
-{
-    throw not_implemented("big_int big_int::operator-(const big_int &) const", "your code should be here...");
-}
+        return progress;
+    }
 
-big_int big_int::operator*(const big_int &other) const
-{
-    throw not_implemented("big_int big_int::operator*(const big_int &) const", "your code should be here...");
-}
+    /** Smallest leading value at position, for which Lehmer step keeps number at least B^s, 0 if there is none
+     */
+    limb lehmer_limit(size_t position, size_t s) noexcept
+    {
+        if (s * limb_bits <= position + 32)
+            return lehmer_min_limit;
 
-big_int big_int::operator/(const big_int &other) const
-{
-    throw not_implemented("big_int big_int::operator/(const big_int &) const", "your code should be here...");
-}
+        size_t k = s * limb_bits - position;
+        return k <= 62 ? (limb(1) << k) + (limb(1) << 31) : 0;
+    }
 
-big_int big_int::operator%(const big_int &other) const
-{
-    throw not_implemented("big_int big_int::operator%(const big_int &) const", "your code should be here...");
-}
+    /** Multi-limb reduction matrix of half-gcd, (a; b) = M (a'; b') with non-negative entries and determinant 1.
+     *  xgcd needs only the second row, first_row is false then
+     */
+    struct gcd_matrix
+    {
+        limb_vector u00, u01, u10, u11;
+        bool first_row;
 
-big_int big_int::operator&(const big_int &other) const
-{
-    throw not_implemented("big_int big_int::operator&(const big_int &) const", "your code should be here...");
-}
+        explicit gcd_matrix(pp_allocator<limb> allocator, bool first_row = true)
+            : u00(1, 1, allocator), u01(allocator), u10(allocator), u11(1, 1, allocator), first_row(first_row)
+        {
+        }
 
-big_int big_int::operator|(const big_int &other) const
-{
-    throw not_implemented("big_int big_int::operator|(const big_int &) const", "your code should be here...");
-}
+        /** (x0, x1) = (x0, x1) * m
+         */
+        static void row_mul_1(limb_vector &x0, limb_vector &x1, const gcd_matrix_1 &m)
+        {
+            size_t n = std::max(x0.size(), x1.size()) + 1;
+            x0.resize(n);
+            x1.resize(n);
 
-big_int big_int::operator^(const big_int &other) const
-{
-    throw not_implemented("big_int big_int::operator^(const big_int &) const", "your code should be here...");
-}
+            limb_vector t(x0);
+            limbs_mul_1(x0.data(), x0.data(), n, m.u00);
+            limbs_addmul_1(x0.data(), x1.data(), n, m.u10);
+            limbs_mul_1(x1.data(), x1.data(), n, m.u11);
+            limbs_addmul_1(x1.data(), t.data(), n, m.u01);
 
-big_int big_int::operator<<(size_t shift) const
-{
-    throw not_implemented("big_int big_int::operator<<(size_t ) const", "your code should be here...");
-}
+            strip_zeros(x0);
+            strip_zeros(x1);
+        }
 
-big_int big_int::operator>>(size_t shift) const
-{
-    throw not_implemented("big_int big_int::operator>>(size_t) const", "your code should be here...");
-}
+        /** r += x * y
+         */
+        static void addmul(limb_vector &r, const limb_vector &x, const limb_vector &y)
+        {
+            if (x.empty() || y.empty())
+                return;
 
-big_int &big_int::operator%=(const big_int &other) &
-{
-    throw not_implemented("big_int &big_int::operator%=(const big_int &)", "your code should be here...");
-}
+            const limb_vector &a = x.size() >= y.size() ? x : y, &b = x.size() >= y.size() ? y : x;
+            limb_vector product(a.size() + b.size(), 0, r.get_allocator());
 
-big_int big_int::operator~() const
-{
-    throw not_implemented("big_int big_int::operator~() const", "your code should be here...");
-}
+            if (b.size() < karatsuba_cutoff())
+                limbs_mul_basecase(product.data(), a.data(), a.size(), b.data(), b.size());
+            else
+                limbs_mul(product.data(), a.data(), a.size(), b.data(), b.size(), r.get_allocator());
 
-big_int &big_int::operator&=(const big_int &other) &
-{
-    throw not_implemented("big_int &big_int::operator&=(const big_int &)", "your code should be here...");
-}
+            if (r.size() < product.size())
+                r.resize(product.size());
 
-big_int &big_int::operator|=(const big_int &other) &
-{
-    throw not_implemented("big_int &big_int::operator|=(const big_int &)", "your code should be here...");
-}
+            r.push_back(0);
+            limbs_add(r.data(), r.data(), r.size(), product.data(), product.size());
+            strip_zeros(r);
+        }
 
-big_int &big_int::operator^=(const big_int &other) &
-{
-    throw not_implemented("big_int &big_int::operator^=(const big_int &)", "your code should be here...");
-}
+        static void row_mul(limb_vector &x0, limb_vector &x1, const gcd_matrix &m)
+        {
+            limb_vector y0(x0.get_allocator()), y1(x0.get_allocator());
 
-big_int &big_int::operator<<=(size_t shift) &
-{
-    throw not_implemented("big_int &big_int::operator<<=(size_t)", "your code should be here...");
-}
+            addmul(y0, x0, m.u00);
+            addmul(y0, x1, m.u10);
+            addmul(y1, x0, m.u01);
+            addmul(y1, x1, m.u11);
 
-big_int &big_int::operator>>=(size_t shift) &
-{
-    throw not_implemented("big_int &big_int::operator>>=(size_t)", "your code should be here...");
+            x0 = std::move(y0);
+            x1 = std::move(y1);
+        }
+
+        void mul_1(const gcd_matrix_1 &m)
+        {
+            if (first_row)
+                row_mul_1(u00, u01, m);
+            row_mul_1(u10, u11, m);
+        }
+
+        void mul(const gcd_matrix &m)
+        {
+            if (first_row)
+                row_mul(u00, u01, m);
+            row_mul(u10, u11, m);
+        }
+
+        /** Division step a -= q * b (reduced_a) or b -= q * a
+         */
+        void add_column(const limb_vector &q, bool reduced_a)
+        {
+            if (first_row)
+                reduced_a ? addmul(u01, q, u00) : addmul(u00, q, u01);
+            reduced_a ? addmul(u11, q, u10) : addmul(u10, q, u11);
+        }
+    };
+
+    /** Pads a and b to the common length of the longer one
+     */
+    void gcd_trim(limb_vector &a, limb_vector &b)
+    {
+        size_t n = std::max(limbs_normalised_size(a.data(), a.size()), limbs_normalised_size(b.data(), b.size()));
+        a.resize(n);
+        b.resize(n);
+    }
+
+    /** (a; b) = m^-1 (a; b), results are non-negative by choice of m
+     */
+    void lehmer_apply(limb_vector &a, limb_vector &b, const gcd_matrix_1 &m)
+    {
+        size_t n = a.size();
+        limb_vector t(a);
+
+        limbs_mul_1(a.data(), a.data(), n, m.u11);
+        limbs_submul_1(a.data(), b.data(), n, m.u01);
+        limbs_mul_1(b.data(), b.data(), n, m.u00);
+        limbs_submul_1(b.data(), t.data(), n, m.u10);
+    }
+
+    /** Euclid step on the larger of a and b, which are both nonzero. It is only made if remainder stays at least B^s
+     *  (any remainder for s == 0). Returns false if no step was made
+     */
+    bool gcd_division_step(limb_vector &a, limb_vector &b, size_t s, gcd_matrix *m)
+    {
+        auto allocator = a.get_allocator();
+        size_t an = limbs_normalised_size(a.data(), a.size()), bn = limbs_normalised_size(b.data(), b.size());
+        bool reduce_a = limbs_compare(a.data(), an, b.data(), bn) >= 0;
+
+        limb_vector &x = reduce_a ? a : b;
+        const limb_vector &y = reduce_a ? b : a;
+        size_t xn = reduce_a ? an : bn, yn = reduce_a ? bn : an;
+
+        limb_vector q(xn - yn + 1, 0, allocator), r(yn, 0, allocator);
+
+        if (yn == 1)
+            r[0] = limbs_divrem_1(q.data(), x.data(), xn, y[0]);
+        else
+            limbs_divrem(q.data(), r.data(), x.data(), xn, y.data(), yn, allocator);
+
+        if (s != 0 && limbs_normalised_size(r.data(), yn) <= s)
+            return false;
+
+        std::fill(x.begin(), x.end(), 0);
+        std::copy(r.begin(), r.end(), x.begin());
+
+        if (m != nullptr)
+        {
+            strip_zeros(q);
+            m->add_column(q, reduce_a);
+        }
+
+        gcd_trim(a, b);
+        return true;
+    }
+
+    /** Lehmer step on leading bits or, if it makes no progress, a division step, both keeping a and b at least B^s
+     */
+    bool gcd_step(limb_vector &a, limb_vector &b, size_t s, gcd_matrix *m)
+    {
+        size_t n = a.size();
+
+        if (n >= 2)
+        {
+            unsigned shift = std::countl_zero(a[n - 1] | b[n - 1]);
+            limb x = a[n - 1], y = b[n - 1];
+
+            if (shift != 0)
+            {
+                x = (x << shift) | (a[n - 2] >> (limb_bits - shift));
+                y = (y << shift) | (b[n - 2] >> (limb_bits - shift));
+            }
+
+            limb limit = lehmer_limit((n - 1) * limb_bits - shift, s);
+            gcd_matrix_1 m1;
+
+            if (limit != 0 && lehmer_matrix(x, y, limit, m1))
+            {
+                lehmer_apply(a, b, m1);
+
+                if (m != nullptr)
+                    m->mul_1(m1);
+
+                gcd_trim(a, b);
+                return true;
+            }
+        }
+
+        return gcd_division_step(a, b, s, m);
+    }
+
+    size_t hgcd_cutoff() noexcept
+    {
+        return std::max<size_t>(big_int::hgcd_threshold, 4);
+    }
+
+    bool hgcd(limb_vector &a, limb_vector &b, gcd_matrix &m);
+
+    /** hi * B^p + plus - minus, which is known to be non-negative
+     */
+    limb_vector hgcd_adjust(const limb_vector &hi, size_t p, const limb_vector &plus, const limb_vector &minus)
+    {
+        limb_vector res(std::max(hi.size() + p, plus.size()) + 1, 0, hi.get_allocator());
+
+        std::copy(hi.begin(), hi.end(), res.begin() + p);
+        limbs_add(res.data(), res.data(), res.size(), plus.data(), plus.size());
+        limbs_sub(res.data(), res.data(), res.size(), minus.data(), minus.size());
+
+        return res;
+    }
+
+    /** Half-gcd of the leading n - p limbs of a and b, its matrix m is then applied to whole a and b:
+     *  a = a' * B^p + u11 * a_low - u01 * b_low, b = b' * B^p + u00 * b_low - u10 * a_low. m must be identity
+     */
+    bool hgcd_reduce(limb_vector &a, limb_vector &b, size_t p, gcd_matrix &m)
+    {
+        auto allocator = a.get_allocator();
+        limb_vector a_high(a.begin() + p, a.end(), allocator), b_high(b.begin() + p, b.end(), allocator);
+
+        if (!hgcd(a_high, b_high, m))
+            return false;
+
+        limb_vector a_low(a.begin(), a.begin() + p, allocator), b_low(b.begin(), b.begin() + p, allocator);
+        strip_zeros(a_low);
+        strip_zeros(b_low);
+        strip_zeros(a_high);
+        strip_zeros(b_high);
+
+        limb_vector a_plus(allocator), a_minus(allocator), b_plus(allocator), b_minus(allocator);
+        gcd_matrix::addmul(a_plus, m.u11, a_low);
+        gcd_matrix::addmul(a_minus, m.u01, b_low);
+        gcd_matrix::addmul(b_plus, m.u00, b_low);
+        gcd_matrix::addmul(b_minus, m.u10, a_low);
+
+        a = hgcd_adjust(a_high, p, a_plus, a_minus);
+        b = hgcd_adjust(b_high, p, b_plus, b_minus);
+        gcd_trim(a, b);
+
+        return true;
+    }
+
+    /** Reduces n-limb a and b (common length, n is length of the longer) while both stay at least B^s, s = n / 2 + 1,
+     *  so that they are about half as long, and accumulates steps into m. Two recursive calls on leading parts
+     *  (Moller's variant of Schonhage's algorithm), Lehmer steps below hgcd_threshold limbs.
+     *  Returns false if no step was made
+     */
+    bool hgcd(limb_vector &a, limb_vector &b, gcd_matrix &m)
+    {
+        size_t n = a.size(), s = n / 2 + 1;
+
+        if (limbs_normalised_size(a.data(), n) <= s || limbs_normalised_size(b.data(), n) <= s)
+            return false;
+
+        bool progress = false;
+
+        if (n >= hgcd_cutoff())
+        {
+            // leading half gives quarter of reduction, up to about 3n / 4 limbs
+            progress = hgcd_reduce(a, b, n / 2, m);
+
+            while (a.size() > 3 * n / 4 + 1)
+            {
+                if (!gcd_step(a, b, s, &m))
+                    return progress;
+
+                progress = true;
+            }
+
+            if (a.size() > s + 2)
+            {
+                // leading part is chosen so that its own limit maps onto s
+                gcd_matrix m2(a.get_allocator());
+
+                if (hgcd_reduce(a, b, 2 * s - a.size() + 1, m2))
+                {
+                    m.mul(m2);
+                    progress = true;
+                }
+            }
+        }
+
+        while (gcd_step(a, b, s, &m))
+            progress = true;
+
+        return progress;
+    }
+
+    /** gcd of a and b, padded to common length. Result is left in one of them, the other becomes zero.
+     *  m accumulates reduction matrix, (a; b)_input = m (a; b). Returns true if result is in a
+     */
+    bool limbs_gcd(limb_vector &a, limb_vector &b, gcd_matrix *m)
+    {
+        gcd_trim(a, b);
+
+        auto nonzero = [](const limb_vector &v)
+        {
+            return limbs_normalised_size(v.data(), v.size()) != 0;
+        };
+
+        while (a.size() >= hgcd_cutoff() && nonzero(a) && nonzero(b))
+        {
+            gcd_matrix reduction(a.get_allocator());
+
+            if (!hgcd_reduce(a, b, a.size() / 2, reduction))
+                gcd_division_step(a, b, 0, m);
+            else if (m != nullptr)
+                m->mul(reduction);
+        }
+
+        // cofactors need steps down to zero, plain gcd finishes on single limbs by binary algorithm
+        while (nonzero(a) && nonzero(b) && (m != nullptr || a.size() >= 2))
+            gcd_step(a, b, 0, m);
+
+        if (nonzero(a) && nonzero(b))
+        {
+            a[0] = gcd_1(a[0], b[0]);
+            b[0] = 0;
+        }
+
+        return nonzero(a) || !nonzero(b);
+    }
 }
 
-big_int &big_int::plus_assign(const big_int &other, size_t shift) &
+big_int big_int::gcd(const big_int &a, const big_int &b)
 {
-    throw not_implemented("big_int &big_int::plus_assign(const big_int &, size_t)", "your code should be here...");
+    auto allocator = a._digits.get_allocator();
+    big_int res(allocator);
+
+    if (a._digits.size() <= 2 && b._digits.size() <= 2)
+    {
+        limb a1 = a._digits.size() > 1 ? a._digits[1] : 0, a0 = a._digits.empty() ? 0 : a._digits[0];
+        limb b1 = b._digits.size() > 1 ? b._digits[1] : 0, b0 = b._digits.empty() ? 0 : b._digits[0];
+
+        gcd_2(a1, a0, b1, b0);
+        res._digits.push_back(a0);
+        res._digits.push_back(a1);
+        res.optimise();
+        return res;
+    }
+
+    limb_vector x(a._digits), y(b._digits);
+    bool in_x = limbs_gcd(x, y, nullptr);
+
+    res._digits = std::move(in_x ? x : y);
+    res.optimise();
+    return res;
 }
 
-big_int &big_int::minus_assign(const big_int &other, size_t shift) &
+big_int big_int::xgcd(const big_int &a, const big_int &b, big_int &s, big_int &t)
 {
-    throw not_implemented("big_int &big_int::minus_assign(const big_int &, size_t)", "your code should be here...");
+    auto allocator = a._digits.get_allocator();
+    big_int g(allocator), u(allocator), v(allocator);
+
+    if (b._digits.empty())
+    {
+        // gcd(a, 0) = |a|, gcd(0, 0) = 0 with zero cofactors
+        g._digits = a._digits;
+        u = big_int(a._digits.empty() ? 0 : a._sign ? 1 : -1, allocator);
+    } else if (a._digits.empty())
+    {
+        g._digits = b._digits;
+        v = big_int(b._sign ? 1 : -1, allocator);
+    } else
+    {
+        limb_vector x(a._digits), y(b._digits);
+        gcd_matrix cofactors(allocator, false);
+        bool in_x = limbs_gcd(x, y, &cofactors);
+
+        // gcd = u11 * |a| - u01 * |b| when it is left in x, -u10 * |a| + u00 * |b| otherwise
+        g._digits = std::move(in_x ? x : y);
+        g.optimise();
+        u._digits = std::move(in_x ? cofactors.u11 : cofactors.u10);
+        u._sign = in_x;
+        u.optimise();
+
+        // smallest cofactor: |u| <= |b| / 2g
+        big_int b_abs(b), a_abs(a);
+        b_abs._sign = a_abs._sign = true;
+
+        big_int period = b_abs.divexact(g);
+        u %= period;
+        if (!u._sign)
+            u += period;
+        if (u + u > period)
+            u -= period;
+
+        v = g - u * a_abs;
+        v.divexact_assign(b_abs);
+
+        if (!a._sign)
+            u = 0_bi - std::move(u);
+        if (!b._sign)
+            v = 0_bi - std::move(v);
+    }
+
+    s = std::move(u);
+    t = std::move(v);
+    return g;
 }
 
-big_int &big_int::operator*=(const big_int &other) &
+namespace
 {
-    throw not_implemented("big_int &big_int::operator*=(const big_int &)", "your code should be here...");
+    size_t bit_length(const limb_vector &digits) noexcept
+    {
+        return digits.empty() ? 0 : (digits.size() - 1) * limb_bits + std::bit_width(digits.back());
+    }
+
+    big_int power(const big_int &base, size_t exponent)
+    {
+        big_int res(1), square(base);
+
+        for (; exponent != 0; exponent >>= 1)
+        {
+            if (exponent & 1)
+                res *= square;
+            if (exponent > 1)
+                square *= square;
+        }
+
+        return res;
+    }
 }
 
-big_int &big_int::operator/=(const big_int &other) &
+big_int big_int::integer_root(const big_int &n, size_t degree)
 {
-    throw not_implemented("big_int &big_int::operator/=(const big_int &)", "your code should be here...");
+    size_t bits = bit_length(n._digits);
+
+    if ((bits + degree - 1) / degree <= 32)
+    {
+        // root below 2^32: double estimate is off by at most one
+        if (bits == 0)
+            return n;
+
+        size_t low = bits > limb_bits ? bits - limb_bits : 0, index = low / limb_bits, offset = low % limb_bits;
+        limb top = n._digits[index] >> offset;
+        if (offset != 0 && index + 1 < n._digits.size())
+            top |= n._digits[index + 1] << (limb_bits - offset);
+
+        double estimate = std::exp2((std::log2(static_cast<double>(top)) + static_cast<double>(low)) / static_cast<double>(degree));
+        big_int x(static_cast<limb>(std::min(estimate, 4294967295.0)), n._digits.get_allocator());
+
+        while (power(x, degree) > n)
+            x -= 1_bi;
+        while (power(x + 1_bi, degree) <= n)
+            x += 1_bi;
+
+        return x;
+    }
+
+    // x0 = (root(n >> degree * shift) + 1) << shift is above root by at most 2^shift, then one Newton step
+    // from above lands on floor or floor + 1 while (degree - 1) * 2^(2 * shift) <= 2 * root
+    size_t shift = std::max<size_t>(((bits - 1) / degree + 1 - std::bit_width(degree - 1)) / 2, 1);
+    big_int x = (integer_root(n >> (degree * shift), degree) + 1_bi) << shift;
+
+    big_int k(static_cast<limb>(degree), n._digits.get_allocator());
+    x = (x * (k - 1_bi) + n / power(x, degree - 1)) / k;
+
+    while (power(x, degree) > n)
+        x -= 1_bi;
+
+    return x;
 }
 
-std::string big_int::to_string() const
+big_int big_int::isqrt() const
 {
-    throw not_implemented("std::string big_int::to_string() const", "your code should be here...");
+    return iroot(2);
 }
 
-std::ostream &operator<<(std::ostream &stream, const big_int &value)
+big_int big_int::iroot(size_t degree) const
 {
-    throw not_implemented("std::ostream &operator<<(std::ostream &, const big_int &)", "your code should be here...");
+    if (degree == 0)
+        throw std::invalid_argument("big_int: root of degree zero");
+
+    if (degree == 1 || _digits.empty())
+        return *this;
+
+    if (!_sign)
+    {
+        if (degree % 2 == 0)
+            throw std::invalid_argument("big_int: even root of negative value");
+
+        big_int magnitude(*this);
+        magnitude._sign = true;
+        return 0_bi - integer_root(magnitude, degree);
+    }
+
+    return integer_root(*this, degree);
 }
 
-std::istream &operator>>(std::istream &stream, big_int &value)
+bool big_int::is_perfect_square() const
 {
-    throw not_implemented("std::istream &operator>>(std::istream &, big_int &)", "your code should be here...");
+    if (!_sign)
+        return false;
+
+    if (_digits.empty())
+        return true;
+
+    // bit r is set when r is a square modulo 64
+    constexpr limb squares_mod_64 = 0x0202021202030213ull;
+
+    if (!((squares_mod_64 >> (_digits[0] & 63)) & 1))
+        return false;
+
+    big_int root = isqrt();
+    return root * root == *this;
 }
 
-bool big_int::operator==(const big_int &other) const noexcept
+bool big_int::is_perfect_power() const
 {
-    throw not_implemented("bool big_int::operator==(const big_int &) const noexcept", "your code should be here...");
+    if (_digits.empty() || (_digits.size() == 1 && _digits[0] == 1))
+        return true;
+
+    if (_sign && is_perfect_square())
+        return true;
+
+    size_t bits = bit_length(_digits);
+
+    for (size_t degree = 3; degree <= bits; degree += 2)
+    {
+        bool prime = true;
+
+        for (size_t d = 3; d * d <= degree && prime; d += 2)
+            prime = degree % d != 0;
+
+        if (prime && power(iroot(degree), degree) == *this)
+            return true;
+    }
+
+    return false;
 }
 
-big_int::big_int(const std::vector<unsigned int, pp_allocator<unsigned int>> &digits, bool sign)
+void big_int::parallel_range(size_t begin, size_t end, size_t threads, const std::function<void(size_t, size_t)> &body)
 {
-    throw not_implemented("big_int::big_int(const std::vector<unsigned int, pp_allocator<unsigned int>> &digits, bool sign)", "your code should be here...");
+    parallel_for(begin, end, threads, body);
 }
 
-big_int::big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits, bool sign) noexcept
+big_int big_int::product_tree(std::vector<big_int> &values, size_t threads)
 {
-    throw not_implemented("big_int::big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits, bool sign) noexcept", "your code should be here...");
+    if (values.empty())
+        return big_int(1);
+
+    if (threads == 0)
+        threads = parallelism;
+
+    std::vector<size_t> prefix(values.size() + 1, 0); // limbs before each value
+
+    for (size_t i = 0; i < values.size(); ++i)
+        prefix[i + 1] = prefix[i] + values[i]._digits.size();
+
+    // subtrees run on calling thread, so operands allocate from their memory resource on one thread only;
+    // threads go to multiplication kernels, which work in preallocated scratch
+    auto multiply = [&](auto &self, size_t lo, size_t hi) -> big_int
+    {
+        if (hi - lo == 1)
+            return std::move(values[lo]);
+
+        // short runs stay below Karatsuba, so folding is as fast as the tree
+        if (prefix[hi] - prefix[lo] < karatsuba_cutoff())
+        {
+            big_int res = std::move(values[lo]);
+
+            for (size_t i = lo + 1; i < hi; ++i)
+                res *= values[i];
+
+            return res;
+        }
+
+        size_t middle = std::upper_bound(prefix.begin() + lo + 1, prefix.begin() + hi, (prefix[lo] + prefix[hi]) / 2) - prefix.begin();
+        middle = std::clamp(middle, lo + 1, hi - 1);
+
+        big_int left = self(self, lo, middle), right = self(self, middle, hi);
+
+        return std::move(left.multiply_assign(right, left.decide_mult(right._digits.size()), threads));
+    };
+
+    return multiply(multiply, 0, values.size());
 }
 
-big_int::big_int(const std::string &num, unsigned int radix, pp_allocator<unsigned int>)
+namespace
 {
-    throw not_implemented("big_int::big_int(const std::string &num, unsigned int radix, pp_allocator<unsigned int>)", "your code should be here...");
+    /** Odd primes up to n by sieve of odd numbers
+     */
+    std::vector<size_t> odd_primes(size_t n)
+    {
+        std::vector<size_t> primes;
+
+        if (n < 3)
+            return primes;
+
+        std::vector<bool> composite((n - 1) / 2, false); // index i stands for 2i + 3
+
+        for (size_t i = 0; i < composite.size(); ++i)
+        {
+            if (composite[i])
+                continue;
+
+            size_t p = 2 * i + 3;
+            primes.push_back(p);
+
+            for (size_t j = (p * p - 3) / 2; p <= n / p && j < composite.size(); j += p)
+                composite[j] = true;
+        }
+
+        return primes;
+    }
+
+    /** Small factors are packed into limbs before they go to product tree
+     */
+    class packed_factors final
+    {
+        std::vector<big_int> _values;
+        limb _current = 1;
+
+    public:
+
+        void push(limb value, size_t count = 1)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (_current > std::numeric_limits<limb>::max() / value)
+                {
+                    _values.emplace_back(_current);
+                    _current = 1;
+                }
+
+                _current *= value;
+            }
+        }
+
+        std::vector<big_int> &values()
+        {
+            if (_current != 1)
+                _values.emplace_back(_current);
+
+            _current = 1;
+            return _values;
+        }
+    };
 }
 
-big_int::big_int(pp_allocator<unsigned int>)
+big_int big_int::factorial(size_t n, size_t threads)
 {
-    throw not_implemented("big_int::big_int(pp_allocator<unsigned int>)", "your code should be here...");
+    // n! = odd(n) * 2^(n - popcount(n)), odd(n) = odd(n / 2)^2 * oddswing(n)
+    auto primes = odd_primes(n);
+    big_int res(1);
+
+    for (size_t level = std::bit_width(n); level-- > 0;)
+    {
+        size_t m = n >> level;
+
+        if (m < 3)
+            continue;
+
+        // exponent of p in swing(m) is count of odd floor(m / p^i)
+        packed_factors swing;
+
+        for (size_t p : primes)
+        {
+            if (p > m)
+                break;
+
+            size_t exponent = 0;
+
+            for (size_t q = m / p; q != 0; q /= p)
+                exponent += q & 1;
+
+            swing.push(p, exponent);
+        }
+
+        res = res * res;
+        big_int factor = product_tree(swing.values(), threads);
+        res.multiply_assign(factor, res.decide_mult(factor._digits.size()), threads);
+    }
+
+    return res << (n - std::popcount(n));
 }
 
-big_int &big_int::multiply_assign(const big_int &other, big_int::multiplication_rule rule) &
+big_int big_int::binomial(size_t n, size_t k, size_t threads)
 {
-    throw not_implemented("big_int &big_int::multiply_assign(const big_int &other, big_int::multiplication_rule rule) &", "your code should be here...");
+    if (k > n)
+        return big_int(0);
+
+    k = std::min(k, n - k);
+
+    // sieve up to n does not pay off for short k: falling factorial is divided by k! exactly
+    if (k < n / 32)
+    {
+        packed_factors falling;
+
+        for (size_t i = 0; i < k; ++i)
+            falling.push(n - i);
+
+        return product_tree(falling.values(), threads).divexact(factorial(k, threads));
+    }
+
+    // Kummer: exponent of p is count of borrows in k + (n - k) base p, p^i <= n
+    packed_factors factors;
+    size_t twos = std::popcount(k) + std::popcount(n - k) - std::popcount(n);
+
+    for (size_t p : odd_primes(n))
+    {
+        size_t exponent = 0;
+
+        for (size_t power = p;; power *= p)
+        {
+            exponent += n / power - k / power - (n - k) / power;
+
+            if (power > n / p)
+                break;
+        }
+
+        factors.push(p, exponent);
+    }
+
+    return product_tree(factors.values(), threads) << twos;
 }
 
-big_int &big_int::divide_assign(const big_int &other, big_int::division_rule rule) &
+namespace
 {
-    throw not_implemented("big_int &big_int::divide_assign(const big_int &other, big_int::division_rule rule) &", "your code should be here...");
+    constexpr limb trial_division_bound = 2048;
+
+    /** Odd primes below trial_division_bound packed into products that fit a limb, so one pass over
+     *  the limbs of value finds residues of several primes
+     */
+    struct trial_division_group
+    {
+        limb product;
+        std::vector<limb> primes;
+    };
+
+    const std::vector<trial_division_group> &trial_division_groups()
+    {
+        static const std::vector<trial_division_group> groups = []
+        {
+            std::vector<trial_division_group> res;
+
+            for (size_t p : odd_primes(trial_division_bound))
+            {
+                if (res.empty() || res.back().product > std::numeric_limits<limb>::max() / p)
+                    res.push_back({1, {}});
+
+                res.back().product *= p;
+                res.back().primes.push_back(p);
+            }
+
+            return res;
+        }();
+
+        return groups;
+    }
+
+    /** Jacobi symbol (a / m) for odd m
+     */
+    int jacobi(limb a, limb m) noexcept
+    {
+        int res = 1;
+        a %= m;
+
+        while (a != 0)
+        {
+            unsigned twos = std::countr_zero(a);
+            a >>= twos;
+
+            // (2 / m) = -1 for m = 3, 5 mod 8
+            if ((twos & 1) && ((m & 7) == 3 || (m & 7) == 5))
+                res = -res;
+
+            // reciprocity flips sign when both are 3 mod 4
+            if ((a & 3) == 3 && (m & 3) == 3)
+                res = -res;
+
+            std::swap(a, m);
+            a %= m;
+        }
+
+        return m == 1 ? res : 0;
+    }
+
+    size_t trailing_zeros(const limb_vector &digits) noexcept
+    {
+        size_t i = 0;
+
+        while (digits[i] == 0)
+            ++i;
+
+        return i * limb_bits + std::countr_zero(digits[i]);
+    }
+
+    bool limbs_equal(const limb *a, const limb *b, size_t n) noexcept
+    {
+        return std::equal(a, a + n, b);
+    }
+
+    bool limbs_is_zero(const limb *a, size_t n) noexcept
+    {
+        return std::all_of(a, a + n, [](limb x) { return x == 0; });
+    }
+
+    /** Residue arithmetic modulo m for operands in [0, m), r may be equal to either operand
+     */
+    void limbs_add_mod(limb *r, const limb *a, const limb *b, const limb *m, size_t n) noexcept
+    {
+        if (limbs_add_n(r, a, b, n) != 0 || limbs_compare(r, n, m, n) >= 0)
+            limbs_sub_n(r, r, m, n);
+    }
+
+    void limbs_sub_mod(limb *r, const limb *a, const limb *b, const limb *m, size_t n) noexcept
+    {
+        if (limbs_sub_n(r, a, b, n) != 0)
+            limbs_add_n(r, r, m, n);
+    }
+
+    void limbs_half_mod(limb *r, const limb *m, size_t n) noexcept
+    {
+        limb carry = r[0] & 1 ? limbs_add_n(r, r, m, n) : 0;
+        limbs_rshift(r, r, n, 1);
+        r[n - 1] |= carry << (limb_bits - 1);
+    }
+
+    /** Strong probable prime test to base a: with m - 1 = d * 2^s, a^d = 1 or a^(d * 2^r) = -1 for some r < s.
+     *  Residues are in Montgomery form, x is workspace of n limbs
+     */
+    bool miller_rabin(montgomery_context &context, const limb *base_m, const limb_vector &d, size_t s,
+                      const limb *one, const limb *minus_one, limb *x, pp_allocator<limb> allocator)
+    {
+        size_t n = context.size();
+        montgomery_pow(context, x, base_m, d, allocator);
+
+        if (limbs_equal(x, one, n) || limbs_equal(x, minus_one, n))
+            return true;
+
+        for (size_t r = 1; r < s; ++r)
+        {
+            context.sqr(x, x);
+
+            if (limbs_equal(x, minus_one, n))
+                return true;
+
+            // nontrivial square root of 1
+            if (limbs_equal(x, one, n))
+                return false;
+        }
+
+        return false;
+    }
+
+    /** Strong Lucas probable prime test with P = 1: with m + 1 = d * 2^s, U_d = 0 or V_(d * 2^r) = 0 for some r < s.
+     *  Indices are doubled by U_2k = U_k V_k, V_2k = V_k^2 - 2Q^k and incremented by U_(k+1) = (U_k + V_k) / 2,
+     *  V_(k+1) = (D U_k + V_k) / 2. Residues are in Montgomery form
+     */
+    bool strong_lucas(montgomery_context &context, const limb *m, const limb *d_m, const limb *q_m, const limb *one,
+                      const limb_vector &d, size_t s, pp_allocator<limb> allocator)
+    {
+        size_t n = context.size();
+        limb_vector u(one, one + n, allocator), v(one, one + n, allocator), q_k(q_m, q_m + n, allocator), t(n, 0, allocator);
+        size_t bits = d.size() * limb_bits - std::countl_zero(d.back());
+
+        // U_1 = 1, V_1 = P = 1, Q^1 = Q
+        for (size_t pos = bits - 1; pos-- > 0;)
+        {
+            context.mul(u.data(), u.data(), v.data());
+            context.sqr(v.data(), v.data());
+            limbs_add_mod(t.data(), q_k.data(), q_k.data(), m, n);
+            limbs_sub_mod(v.data(), v.data(), t.data(), m, n);
+            context.sqr(q_k.data(), q_k.data());
+
+            if ((d[pos / limb_bits] >> (pos % limb_bits)) & 1)
+            {
+                context.mul(t.data(), d_m, u.data());
+                limbs_add_mod(u.data(), u.data(), v.data(), m, n);
+                limbs_half_mod(u.data(), m, n);
+                limbs_add_mod(v.data(), v.data(), t.data(), m, n);
+                limbs_half_mod(v.data(), m, n);
+                context.mul(q_k.data(), q_k.data(), q_m);
+            }
+        }
+
+        if (limbs_is_zero(u.data(), n))
+            return true;
+
+        for (size_t r = 0; r < s; ++r)
+        {
+            if (limbs_is_zero(v.data(), n))
+                return true;
+
+            if (r + 1 < s)
+            {
+                context.sqr(v.data(), v.data());
+                limbs_add_mod(t.data(), q_k.data(), q_k.data(), m, n);
+                limbs_sub_mod(v.data(), v.data(), t.data(), m, n);
+                context.sqr(q_k.data(), q_k.data());
+            }
+        }
+
+        return false;
+    }
 }
 
-big_int &big_int::modulo_assign(const big_int &other, big_int::division_rule rule) &
+bool big_int::is_probable_prime(size_t rounds, primality_test test) const
 {
-    throw not_implemented("big_int &big_int::modulo_assign(const big_int &other, big_int::division_rule rule) &", "your code should be here...");
+    if (!_sign || _digits.empty())
+        return false;
+
+    const limb_vector &m = _digits;
+    size_t n = m.size();
+
+    if ((m[0] & 1) == 0)
+        return n == 1 && m[0] == 2;
+
+    for (const auto &group : trial_division_groups())
+    {
+        limb r = limbs_mod_1(m.data(), n, group.product);
+
+        for (limb p : group.primes)
+        {
+            if (r % p == 0)
+                return n == 1 && m[0] == p;
+        }
+    }
+
+    if (n == 1 && m[0] < trial_division_bound * trial_division_bound)
+        return m[0] != 1;
+
+    auto allocator = _digits.get_allocator();
+    montgomery_context context(m.data(), n, false, allocator);
+
+    big_int r_squared = reduce(big_int(1, allocator) << (2 * n * limb_bits), *this);
+    r_squared._digits.resize(n, 0);
+
+    // Montgomery form of small value
+    auto to_montgomery = [&](long long value)
+    {
+        big_int residue = reduce(big_int(value, allocator), *this);
+        residue._digits.resize(n, 0);
+        context.mul(residue._digits.data(), residue._digits.data(), r_squared._digits.data());
+        return residue;
+    };
+
+    big_int one = to_montgomery(1), minus_one = to_montgomery(-1);
+
+    big_int d = *this - big_int(1, allocator);
+    size_t s = trailing_zeros(d._digits);
+    d >>= s;
+
+    limb_vector x(n, 0, allocator);
+
+    // bases up to 37 are a proof below 2^64
+    if (n == 1)
+    {
+        for (long long base : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37})
+        {
+            if (!miller_rabin(context, to_montgomery(base)._digits.data(), d._digits, s, one._digits.data(), minus_one._digits.data(), x.data(), allocator))
+                return false;
+        }
+
+        return true;
+    }
+
+    thread_local std::mt19937_64 generator(std::random_device{}());
+
+    for (size_t i = 0; i < std::max<size_t>(rounds, 1); ++i)
+    {
+        big_int base = i == 0 ? big_int(2, allocator) : random_below(*this - big_int(3, allocator), generator) + big_int(2, allocator);
+        base._digits.resize(n, 0);
+        context.mul(base._digits.data(), base._digits.data(), r_squared._digits.data());
+
+        if (!miller_rabin(context, base._digits.data(), d._digits, s, one._digits.data(), minus_one._digits.data(), x.data(), allocator))
+            return false;
+    }
+
+    if (test == primality_test::MillerRabin)
+        return true;
+
+    // Selfridge: first D of 5, -7, 9, -11, ... with (D / m) = -1, none exists for squares
+    long long discriminant = 5;
+
+    for (;; discriminant = discriminant > 0 ? -discriminant - 2 : -discriminant + 2)
+    {
+        limb abs = static_cast<limb>(discriminant > 0 ? discriminant : -discriminant);
+        int symbol = jacobi(limbs_mod_1(m.data(), n, abs), abs);
+
+        // (m / |D|) to (D / m) by reciprocity, (-1 / m) = -1 for m = 3 mod 4
+        if ((abs & 3) == 3 && (m[0] & 3) == 3)
+            symbol = -symbol;
+        if (discriminant < 0 && (m[0] & 3) == 3)
+            symbol = -symbol;
+
+        if (symbol == -1)
+            break;
+
+        if (symbol == 0)
+            return false;
+
+        if (discriminant == 13 && is_perfect_square())
+            return false;
+    }
+
+    big_int d_m = to_montgomery(discriminant), q_m = to_montgomery((1 - discriminant) / 4);
+
+    d = *this + big_int(1, allocator);
+    s = trailing_zeros(d._digits);
+    d >>= s;
+
+    return strong_lucas(context, m.data(), d_m._digits.data(), q_m._digits.data(), one._digits.data(), d._digits, s, allocator);
 }
 
 big_int operator""_bi(unsigned long long n)
 {
-    throw not_implemented("big_int operator\"\"_bi(unsigned long long n)", "your code should be here...");
-}
\ No newline at end of file
+    return big_int(n);
+}
@@ -0,0 +1,419 @@
+#include "../include/rns_int.h"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+namespace
+{
+    using limb = rns_basis::value_type;
+
+    /** a * b mod m for a, b < m
+     */
+    limb mul_mod(limb a, limb b, limb m) noexcept
+    {
+        limb hi, rem;
+        limb lo = __detail::multiply_wide(a, b, hi);
+        __detail::divide_wide(hi, lo, m, rem);
+        return rem;
+    }
+
+    limb pow_mod(limb base, limb exponent, limb m) noexcept
+    {
+        limb res = 1 % m;
+
+        for (; exponent != 0; exponent >>= 1)
+        {
+            if (exponent & 1)
+                res = mul_mod(res, base, m);
+            base = mul_mod(base, base, m);
+        }
+
+        return res;
+    }
+
+    /** Miller-Rabin with the first twelve primes as bases is exact below 2^64
+     */
+    bool is_prime(limb n) noexcept
+    {
+        constexpr limb bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+        if (n < 2)
+            return false;
+
+        for (limb base : bases)
+        {
+            if (n % base == 0)
+                return n == base;
+        }
+
+        limb d = n - 1;
+        unsigned int s = std::countr_zero(d);
+        d >>= s;
+
+        for (limb base : bases)
+        {
+            limb x = pow_mod(base, d, n);
+
+            if (x == 1 || x == n - 1)
+                continue;
+
+            bool composite = true;
+
+            for (unsigned int i = 1; i < s && composite; ++i)
+            {
+                x = mul_mod(x, x, n);
+                composite = x != n - 1;
+            }
+
+            if (composite)
+                return false;
+        }
+
+        return true;
+    }
+
+    /** Primes below 2^62 in descending order, found once for all bases
+     */
+    limb basis_prime(size_t index)
+    {
+        static std::mutex mutex;
+        static std::vector<limb> primes;
+
+        std::lock_guard lock(mutex);
+
+        while (primes.size() <= index)
+        {
+            limb candidate = primes.empty() ? (limb(1) << 62) - 1 : primes.back() - 2;
+
+            while (!is_prime(candidate))
+                candidate -= 2;
+
+            primes.push_back(candidate);
+        }
+
+        return primes[index];
+    }
+
+    /** (hi * 2^64 + lo) * 2^-64 mod p for hi < p < 2^62
+     */
+    inline limb redc(limb hi, limb lo, limb p, limb inverse) noexcept
+    {
+        limb m = lo * inverse, carry = 0, mh;
+        limb ml = __detail::multiply_wide(m, p, mh);
+        __detail::add_with_carry(lo, ml, carry);
+
+        limb t = hi + mh + carry;
+        return t >= p ? t - p : t;
+    }
+
+    inline limb mont_mul(limb a, limb b, limb p, limb inverse) noexcept
+    {
+        limb hi;
+        limb lo = __detail::multiply_wide(a, b, hi);
+        return redc(hi, lo, p, inverse);
+    }
+
+    inline limb add_mod(limb a, limb b, limb p) noexcept
+    {
+        limb s = a + b;
+        return s >= p ? s - p : s;
+    }
+
+    inline limb sub_mod(limb a, limb b, limb p) noexcept
+    {
+        return a >= b ? a - b : a - b + p;
+    }
+}
+
+rns_basis::rns_basis(size_t bits) : _product(1), _half_product(0)
+{
+    if (bits == 0)
+        throw std::invalid_argument("rns_basis: bits must be positive");
+
+    // every prime is above 2^61, so product of count of them is above 2^(bits + 1)
+    size_t count = (bits + 1) / 61 + 1;
+
+    _primes.reserve(count);
+    _inverses.reserve(count);
+    _r2.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        limb p = basis_prime(i), inverse = p;
+
+        // Newton's iteration doubles correct low bits of p^-1 mod 2^64
+        for (int step = 0; step < 5; ++step)
+            inverse *= 2 - p * inverse;
+
+        limb r1 = (0 - p) % p;
+
+        _primes.push_back(p);
+        _inverses.push_back(0 - inverse);
+        _r2.push_back(mul_mod(r1, r1, p));
+        _product *= big_int(p);
+    }
+
+    _half_product = _product >> 1;
+
+    // Garner's row j: p_i mod p_j for i < j and inverse of their product, all in Montgomery form
+    _garner.reserve(count * (count + 1) / 2);
+
+    for (size_t j = 0; j < count; ++j)
+    {
+        limb p = _primes[j], prefix = 1 % p;
+
+        for (size_t i = 0; i < j; ++i)
+        {
+            limb radix = _primes[i] % p;
+            prefix = mul_mod(prefix, radix, p);
+            _garner.push_back(mont_mul(radix, _r2[j], p, _inverses[j]));
+        }
+
+        _garner.push_back(mont_mul(pow_mod(prefix, p - 2, p), _r2[j], p, _inverses[j]));
+    }
+}
+
+size_t rns_basis::size() const noexcept
+{
+    return _primes.size();
+}
+
+rns_basis::value_type rns_basis::prime(size_t index) const noexcept
+{
+    return _primes[index];
+}
+
+const big_int &rns_basis::product() const noexcept
+{
+    return _product;
+}
+
+rns_int::rns_int(std::shared_ptr<const rns_basis> basis) : _basis(std::move(basis)), _residues(_basis->size(), 0)
+{
+
+}
+
+rns_int::rns_int(const big_int &value, std::shared_ptr<const rns_basis> basis) : _basis(std::move(basis)), _residues(_basis->size(), 0)
+{
+    const auto &digits = value._digits;
+    size_t n = digits.size();
+
+    for_residues(_residues.size(), n + 1, [&](size_t first, size_t last)
+    {
+        for (size_t j = first; j < last; ++j)
+        {
+            limb p = _basis->_primes[j], inverse = _basis->_inverses[j], r2 = _basis->_r2[j];
+
+            // u = value * 2^(-64n) by one reduction per limb from the low end
+            limb u = 0;
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                limb carry = 0;
+                limb lo = __detail::add_with_carry(u, digits[i], carry);
+                u = redc(carry, lo, p, inverse);
+            }
+
+            // Montgomery form value * 2^64 = u * 2^(64(n + 2)) * 2^-64, the power is raised in Montgomery form
+            // starting from 2^128 mod p, which stands for 2^64
+            limb power = redc(0, r2, p, inverse), base = r2;
+
+            for (size_t exponent = n + 2; exponent != 0; exponent >>= 1)
+            {
+                if (exponent & 1)
+                    power = mont_mul(power, base, p, inverse);
+                base = mont_mul(base, base, p, inverse);
+            }
+
+            _residues[j] = mont_mul(u, redc(0, power, p, inverse), p, inverse);
+        }
+    });
+
+    if (!value._sign)
+    {
+        for (size_t j = 0; j < _residues.size(); ++j)
+            _residues[j] = sub_mod(0, _residues[j], _basis->_primes[j]);
+    }
+}
+
+void rns_int::check_basis(const rns_int &other) const
+{
+    if (_basis != other._basis)
+        throw std::invalid_argument("rns_int: operands have different bases");
+}
+
+void rns_int::for_residues(size_t count, size_t cost, const std::function<void(size_t, size_t)> &body)
+{
+    size_t threads = std::min(big_int::parallelism, count);
+
+    if (threads <= 1 || count * cost < 8 * big_int::parallel_threshold)
+        body(0, count);
+    else
+        big_int::parallel_range(0, count, threads, body);
+}
+
+const std::shared_ptr<const rns_basis> &rns_int::basis() const noexcept
+{
+    return _basis;
+}
+
+rns_int::value_type rns_int::residue(size_t index) const noexcept
+{
+    return redc(0, _residues[index], _basis->_primes[index], _basis->_inverses[index]);
+}
+
+big_int rns_int::to_big_int() const
+{
+    const rns_basis &basis = *_basis;
+    size_t k = _residues.size();
+
+    // Garner: value = v_0 + p_0 * (v_1 + p_1 * (v_2 + ...)) with v_j in [0, p_j)
+    std::vector<limb> mixed(k);
+    const limb *row = basis._garner.data();
+
+    for (size_t j = 0; j < k; row += j + 1, ++j)
+    {
+        limb p = basis._primes[j], inverse = basis._inverses[j], r2 = basis._r2[j];
+        limb x = 0;
+
+        for (size_t i = j; i-- > 0;)
+        {
+            // v_i < p_i < 2^62 < 2 * p_j
+            limb v = mixed[i] >= p ? mixed[i] - p : mixed[i];
+            x = add_mod(mont_mul(x, row[i], p, inverse), mont_mul(v, r2, p, inverse), p);
+        }
+
+        mixed[j] = redc(0, mont_mul(sub_mod(_residues[j], x, p), row[j], p, inverse), p, inverse);
+    }
+
+    // Horner on limbs
+    std::vector<limb> digits;
+    digits.reserve(k);
+
+    for (size_t j = k; j-- > 0;)
+    {
+        limb carry = mixed[j];
+
+        for (auto &digit : digits)
+        {
+            limb hi, c = 0;
+            digit = __detail::add_with_carry(__detail::multiply_wide(digit, basis._primes[j], hi), carry, c);
+            carry = hi + c;
+        }
+
+        if (carry != 0)
+            digits.push_back(carry);
+    }
+
+    big_int res;
+    res._digits.resize(digits.size());
+    std::copy(digits.begin(), digits.end(), res._digits.begin());
+    res.optimise();
+
+    if (res > basis._half_product)
+        res -= basis._product;
+
+    return res;
+}
+
+rns_int::operator big_int() const
+{
+    return to_big_int();
+}
+
+rns_int &rns_int::operator+=(const rns_int &other) &
+{
+    check_basis(other);
+
+    const limb *primes = _basis->_primes.data();
+    limb *residues = _residues.data();
+    const limb *others = other._residues.data();
+
+    for_residues(_residues.size(), 1, [=](size_t lo, size_t hi)
+    {
+        for (size_t j = lo; j < hi; ++j)
+            residues[j] = add_mod(residues[j], others[j], primes[j]);
+    });
+
+    return *this;
+}
+
+rns_int rns_int::operator+(const rns_int &other) const
+{
+    rns_int res(*this);
+    res += other;
+    return res;
+}
+
+rns_int &rns_int::operator-=(const rns_int &other) &
+{
+    check_basis(other);
+
+    const limb *primes = _basis->_primes.data();
+    limb *residues = _residues.data();
+    const limb *others = other._residues.data();
+
+    for_residues(_residues.size(), 1, [=](size_t lo, size_t hi)
+    {
+        for (size_t j = lo; j < hi; ++j)
+            residues[j] = sub_mod(residues[j], others[j], primes[j]);
+    });
+
+    return *this;
+}
+
+rns_int rns_int::operator-(const rns_int &other) const
+{
+    rns_int res(*this);
+    res -= other;
+    return res;
+}
+
+rns_int &rns_int::operator*=(const rns_int &other) &
+{
+    check_basis(other);
+
+    const limb *primes = _basis->_primes.data(), *inverses = _basis->_inverses.data();
+    limb *residues = _residues.data();
+    const limb *others = other._residues.data();
+
+    for_residues(_residues.size(), 1, [=](size_t lo, size_t hi)
+    {
+        for (size_t j = lo; j < hi; ++j)
+            residues[j] = mont_mul(residues[j], others[j], primes[j], inverses[j]);
+    });
+
+    return *this;
+}
+
+rns_int rns_int::operator*(const rns_int &other) const
+{
+    rns_int res(*this);
+    res *= other;
+    return res;
+}
+
+rns_int &rns_int::multiply_add(const rns_int &lhs, const rns_int &rhs) &
+{
+    check_basis(lhs);
+    check_basis(rhs);
+
+    const limb *primes = _basis->_primes.data(), *inverses = _basis->_inverses.data();
+
+    limb *residues = _residues.data();
+    const limb *a = lhs._residues.data(), *b = rhs._residues.data();
+
+    for_residues(_residues.size(), 1, [=](size_t lo, size_t hi)
+    {
+        for (size_t j = lo; j < hi; ++j)
+            residues[j] = add_mod(residues[j], mont_mul(a[j], b[j], primes[j], inverses[j]), primes[j]);
+    });
+
+    return *this;
+}
+
+bool rns_int::operator==(const rns_int &other) const
+{
+    check_basis(other);
+    return _residues == other._residues;
+}
@@ -163,6 +163,40 @@ TEST(positive_tests, test7)
     delete logger;
 }
 
+TEST(positive_tests, test8)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    std::vector<unsigned int> digits_1(5000), digits_2(1100, 0xffffffffu);
+    for (size_t i = 0; i < digits_1.size(); ++i)
+        digits_1[i] = static_cast<unsigned int>(i * 2654435761u + 12345u);
+    digits_2[0] = 3;
+    digits_2[700] = 0x7fffffffu;
+
+    big_int bigint_1(digits_1, false);
+    big_int bigint_2(digits_2);
+
+    big_int expected_quotient(bigint_1), expected_remainder(bigint_1);
+    expected_quotient.divide_assign(bigint_2, big_int::division_rule::trivial);
+    expected_remainder.modulo_assign(bigint_2, big_int::division_rule::trivial);
+
+    big_int quotient(bigint_1), remainder(bigint_1);
+    quotient.divide_assign(bigint_2, big_int::division_rule::BurnikelZiegler);
+    remainder.modulo_assign(bigint_2, big_int::division_rule::BurnikelZiegler);
+
+    EXPECT_TRUE(quotient == expected_quotient);
+    EXPECT_TRUE(remainder == expected_remainder);
+    EXPECT_TRUE(quotient * bigint_2 + remainder == bigint_1);
+
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
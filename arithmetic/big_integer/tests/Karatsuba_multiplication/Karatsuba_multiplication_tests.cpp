@@ -165,6 +165,41 @@ TEST(positive_tests_kar, test7)
     delete logger;
 }
 
+TEST(positive_tests_kar, test8)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    std::vector<unsigned int> digits_1(1500), digits_2(700);
+    for (size_t i = 0; i < digits_1.size(); ++i)
+        digits_1[i] = static_cast<unsigned int>(i * 2654435761u + 12345u);
+    for (size_t i = 0; i < digits_2.size(); ++i)
+        digits_2[i] = static_cast<unsigned int>(~(i * 40503u));
+
+    big_int bigint_1(digits_1);
+    big_int bigint_2(digits_2, false);
+
+    big_int expected(bigint_1);
+    expected.multiply_assign(bigint_2, big_int::multiplication_rule::trivial);
+    bigint_1.multiply_assign(bigint_2, big_int::multiplication_rule::Karatsuba);
+
+    EXPECT_TRUE(bigint_1 == expected);
+
+    big_int square(bigint_2);
+    big_int expected_square(bigint_2);
+    expected_square.multiply_assign(bigint_2, big_int::multiplication_rule::trivial);
+    square.multiply_assign(square, big_int::multiplication_rule::Karatsuba);
+
+    EXPECT_TRUE(square == expected_square);
+
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
@@ -163,6 +163,47 @@ TEST(positive_tests, test7)
     delete logger;
 }
 
+TEST(positive_tests, test8)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    std::vector<unsigned int> digits_1(3000), digits_2(400, 0xffffffffu);
+    for (size_t i = 0; i < digits_1.size(); ++i)
+        digits_1[i] = static_cast<unsigned int>(i * 2654435761u + 12345u);
+    digits_2[0] = 0;
+    digits_2[399] = 0x80000000u;
+
+    big_int bigint_1(digits_1);
+    big_int bigint_2(digits_2, false);
+
+    big_int expected_quotient(bigint_1), expected_remainder(bigint_1);
+    expected_quotient.divide_assign(bigint_2, big_int::division_rule::trivial);
+    expected_remainder.modulo_assign(bigint_2, big_int::division_rule::trivial);
+
+    big_int quotient(bigint_1), remainder(bigint_1);
+    quotient.divide_assign(bigint_2, big_int::division_rule::Newton);
+    remainder.modulo_assign(bigint_2, big_int::division_rule::Newton);
+
+    EXPECT_TRUE(quotient == expected_quotient);
+    EXPECT_TRUE(remainder == expected_remainder);
+
+    big_int::divisor divisor(bigint_2);
+    auto [divisor_quotient, divisor_remainder] = divisor.divmod(bigint_1);
+
+    EXPECT_TRUE(divisor_quotient == expected_quotient);
+    EXPECT_TRUE(divisor_remainder == expected_remainder);
+    EXPECT_TRUE(divisor.div(big_int(0) - bigint_1) == big_int(0) - expected_quotient);
+    EXPECT_TRUE(divisor.mod(big_int(0) - bigint_2 + 1_bi) == 1_bi);
+
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <client_logger_builder.h>
+#include <sstream>
+#include <big_int.h>
+#include <client_logger.h>
+#include <client_logger_builder.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+
+    logger *built_logger = builder->build();
+
+    delete builder;
+
+    return built_logger;
+}
+
+big_int make_operand(size_t digits, unsigned int seed, bool sign = true)
+{
+    std::vector<unsigned int> result(digits);
+    for (size_t i = 0; i < digits; ++i)
+        result[i] = static_cast<unsigned int>(i * 2654435761u + seed * 40503u);
+    return big_int(result, sign);
+}
+
+bool check_rule(const big_int &bigint_1, const big_int &bigint_2, big_int::multiplication_rule rule)
+{
+    big_int expected(bigint_1), result(bigint_1);
+    expected.multiply_assign(bigint_2, big_int::multiplication_rule::trivial);
+    result.multiply_assign(bigint_2, rule);
+    return result == expected;
+}
+
+TEST(positive_tests_toom, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    big_int bigint_1("-28958888309635818");
+    big_int bigint_2("-234567");
+    bigint_1.multiply_assign(bigint_2, big_int::multiplication_rule::Toom3);
+
+    EXPECT_TRUE((std::ostringstream() << bigint_1).str() == "6792799554126344920806");
+
+    big_int bigint_3("20944325634363");
+    bigint_3.multiply_assign(0_bi, big_int::multiplication_rule::Toom4);
+
+    EXPECT_TRUE((std::ostringstream() << bigint_3).str() == "0");
+
+    delete logger;
+}
+
+TEST(positive_tests_toom, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    big_int bigint_1 = make_operand(2400, 1);
+    big_int bigint_2 = make_operand(2200, 2, false);
+
+    EXPECT_TRUE(check_rule(bigint_1, bigint_2, big_int::multiplication_rule::Toom3));
+    EXPECT_TRUE(check_rule(bigint_1, bigint_2, big_int::multiplication_rule::Toom4));
+
+    delete logger;
+}
+
+TEST(positive_tests_toom, test3)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    size_t toom3_threshold = big_int::toom3_threshold, toom4_threshold = big_int::toom4_threshold;
+    big_int::toom3_threshold = 0;
+    big_int::toom4_threshold = 0;
+
+    big_int bigint_1 = make_operand(1000, 3, false);
+
+    for (size_t digits : {999, 700, 450, 300, 120})
+    {
+        big_int bigint_2 = make_operand(digits, 4);
+
+        EXPECT_TRUE(check_rule(bigint_1, bigint_2, big_int::multiplication_rule::Toom3));
+        EXPECT_TRUE(check_rule(bigint_2, bigint_1, big_int::multiplication_rule::Toom4));
+    }
+
+    big_int::toom3_threshold = toom3_threshold;
+    big_int::toom4_threshold = toom4_threshold;
+
+    delete logger;
+}
+
+TEST(positive_tests_toom, test4)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    size_t toom3_threshold = big_int::toom3_threshold, toom4_threshold = big_int::toom4_threshold;
+    big_int::toom3_threshold = 0;
+    big_int::toom4_threshold = 0;
+
+    big_int bigint_1 = make_operand(1300, 5);
+    big_int expected_square(bigint_1), square_3(bigint_1), square_4(bigint_1);
+
+    expected_square.multiply_assign(bigint_1, big_int::multiplication_rule::trivial);
+    square_3.multiply_assign(square_3, big_int::multiplication_rule::Toom3);
+    square_4.multiply_assign(square_4, big_int::multiplication_rule::Toom4);
+
+    EXPECT_TRUE(square_3 == expected_square);
+    EXPECT_TRUE(square_4 == expected_square);
+
+    big_int::toom3_threshold = toom3_threshold;
+    big_int::toom4_threshold = toom4_threshold;
+
+    delete logger;
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
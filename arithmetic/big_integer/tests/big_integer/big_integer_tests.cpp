@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <sstream>
+#include <array>
+#include <memory_resource>
 
 #include <big_int.h>
 #include <client_logger.h>
@@ -231,6 +234,451 @@ TEST(positive_tests, test9)
     delete logger;
 }
 
+TEST(positive_tests, test10)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int base("123456789123456789");
+    big_int exponent("98765432109876543211");
+    big_int odd_modulus("1000000000000000000000000000057");
+    big_int even_modulus("1000000000000000000000000000000");
+    big_int mersenne = (1_bi << 127) - 1_bi;
+    
+    EXPECT_TRUE(base.pow_mod(exponent, even_modulus).to_string() == "915152544342788072614056002189");
+    EXPECT_TRUE((0_bi - base).pow_mod(exponent, odd_modulus).to_string() == "757426603647565417572980052398");
+    EXPECT_TRUE((0_bi - base).pow_mod(exponent, odd_modulus, true).to_string() == "757426603647565417572980052398");
+    EXPECT_TRUE(3_bi .pow_mod(mersenne - 1_bi, mersenne) == 1_bi);
+    EXPECT_TRUE(base.inverse_mod(odd_modulus).to_string() == "373269332577874998577538414958");
+    EXPECT_TRUE(base.pow_mod(0_bi - 1_bi, odd_modulus) == base.inverse_mod(odd_modulus));
+    EXPECT_TRUE(base.mul_mod(base, odd_modulus).mul_mod(base, odd_modulus).to_string() == "562699833092400966613373928256");
+    EXPECT_THROW(2_bi .inverse_mod(even_modulus), std::logic_error);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test11)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    std::string digits(200000, '0');
+    for (size_t i = 0; i < digits.size(); ++i)
+        digits[i] = static_cast<char>('0' + (i * 7919 + i / 13) % 10);
+    digits[0] = '9';
+    
+    big_int bigint_1(digits);
+    big_int bigint_2(std::string(70000, 'z'), 36);
+    
+    EXPECT_TRUE(bigint_1.to_string() == digits);
+    EXPECT_TRUE(big_int("-" + digits) == 0_bi - bigint_1);
+    EXPECT_TRUE(big_int(bigint_1.to_string(7), 7) == bigint_1);
+    EXPECT_TRUE(big_int(bigint_1.to_string(16), 16) == bigint_1);
+    EXPECT_TRUE(bigint_2 + 1_bi == big_int("1" + std::string(70000, '0'), 36));
+    
+    std::istringstream stream("  -" + digits + ",12");
+    big_int parsed;
+    stream >> parsed;
+    
+    EXPECT_TRUE(parsed == 0_bi - bigint_1);
+    EXPECT_TRUE(stream.get() == ',');
+    EXPECT_TRUE((std::ostringstream() << std::hex << 255_bi).str() == "ff");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test12)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    struct counting_resource final : std::pmr::memory_resource
+    {
+        size_t allocations = 0;
+        
+        void *do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        
+        void do_deallocate(void *p, size_t bytes, size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    } resource;
+    
+    pp_allocator<big_int::value_type> allocator(&resource);
+    big_int accumulator(1, allocator), factor(-12345, allocator), modulus(1000000007, allocator);
+    
+    for (int i = 0; i < 1000; ++i)
+    {
+        accumulator = (accumulator * factor + big_int(i, allocator)) % modulus;
+    }
+    
+    EXPECT_TRUE(resource.allocations == 0);
+    
+    big_int wide = accumulator << 200;
+    
+    EXPECT_TRUE(resource.allocations > 0);
+    EXPECT_TRUE(wide >> 200 == accumulator);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test13)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("3249832749832749832749832749832749832749827349872349");
+    big_int bigint_2("-9879879879879879879879879879879879879879879");
+    big_int bigint_3("123456789");
+    big_int sum("42");
+    
+    sum.addmul(bigint_1, bigint_2);
+    EXPECT_TRUE(sum == bigint_1 * bigint_2 + 42_bi);
+    
+    sum.submul(bigint_2, bigint_1);
+    sum.submul(bigint_3, bigint_2);
+    EXPECT_TRUE(sum == 42_bi - bigint_3 * bigint_2);
+    
+    sum += big_int::product(bigint_1, bigint_3);
+    sum -= big_int::product(bigint_1, bigint_3);
+    EXPECT_TRUE(sum == 42_bi - bigint_3 * bigint_2);
+    
+    sum.mul_add_assign(bigint_3, bigint_1);
+    EXPECT_TRUE(sum == (42_bi - bigint_3 * bigint_2) * bigint_3 + bigint_1);
+    
+    big_int quotient, remainder;
+    big_int::divmod(bigint_1, bigint_2, quotient, remainder);
+    EXPECT_TRUE(quotient == bigint_1 / bigint_2);
+    EXPECT_TRUE(remainder == bigint_1 % bigint_2);
+    
+    big_int dividend(bigint_2), divisor(bigint_3);
+    big_int::divmod(dividend, divisor, dividend, divisor);
+    EXPECT_TRUE(dividend == bigint_2 / bigint_3);
+    EXPECT_TRUE(divisor == bigint_2 % bigint_3);
+    EXPECT_THROW(big_int::divmod(bigint_1, 0_bi, quotient, remainder), std::logic_error);
+    
+    big_int product = big_int::product(bigint_1, bigint_2);
+    EXPECT_TRUE(product == bigint_1 * bigint_2);
+    EXPECT_TRUE(bigint_1 - big_int(bigint_2) == bigint_1 - bigint_2);
+    EXPECT_TRUE(big_int(bigint_1) * big_int(bigint_2) == product);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test14)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    std::stringstream saved;
+    big_int::save_tuning(saved);
+    
+    std::stringstream table("# tuned\nkaratsuba_threshold 20  # comment\n\ntoom3_threshold 250\n");
+    big_int::load_tuning(table);
+    EXPECT_EQ(big_int::karatsuba_threshold, 20u);
+    EXPECT_EQ(big_int::toom3_threshold, 250u);
+    
+    std::stringstream bad("newton_threshold 10\ntoom4_threshold many\n");
+    EXPECT_THROW(big_int::load_tuning(bad), std::invalid_argument);
+    EXPECT_EQ(big_int::toom4_threshold, 700u);
+    EXPECT_EQ(big_int::newton_threshold, 150u);
+    
+    std::stringstream unknown("fft_threshold 10\n");
+    EXPECT_THROW(big_int::load_tuning(unknown), std::invalid_argument);
+    
+    big_int bigint_1("3249832749832749832749832749832749832749827349872349");
+    big_int bigint_2("-9879879879879879879879879879879879879879879");
+    EXPECT_TRUE((std::ostringstream() << bigint_1 * bigint_2).str() == "-32107957198047288137378227468317558407648441528165262789802699712609622519532429442344103565771");
+    
+    big_int::load_tuning(saved);
+    std::stringstream restored;
+    big_int::save_tuning(restored);
+    EXPECT_EQ(restored.str(), saved.str());
+    
+    delete logger;
+}
+
+TEST(positive_tests, test15)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("3249832749832749832749832749832749832749827349872349");
+    big_int bigint_2("-9879879879879879879879879879879879879879879");
+    big_int common("123456789012345678901234567890123456789");
+    
+    EXPECT_TRUE(big_int::gcd(bigint_1, bigint_2) == 3_bi);
+    EXPECT_TRUE(big_int::gcd(bigint_1 * common, bigint_2 * common) == 3_bi * common);
+    EXPECT_TRUE(big_int::gcd(12_bi, 18_bi) == 6_bi);
+    EXPECT_TRUE(big_int::gcd(0_bi, bigint_2) == 0_bi - bigint_2);
+    EXPECT_TRUE(big_int::gcd(0_bi, 0_bi) == 0_bi);
+    
+    // consecutive Fibonacci numbers of 326 limbs pass through half-gcd with the longest quotient sequence
+    big_int fibonacci_0 = 0_bi, fibonacci_1 = 1_bi;
+    for (int i = 0; i < 30000; ++i)
+    {
+        big_int fibonacci_2 = fibonacci_0 + fibonacci_1;
+        fibonacci_0 = std::move(fibonacci_1);
+        fibonacci_1 = std::move(fibonacci_2);
+    }
+    
+    EXPECT_TRUE(big_int::gcd(fibonacci_1, fibonacci_0) == 1_bi);
+    EXPECT_TRUE(big_int::gcd(fibonacci_1 * common, fibonacci_0 * common) == common);
+    
+    big_int s, t;
+    EXPECT_TRUE(big_int::xgcd(fibonacci_1 * common, fibonacci_0 * common, s, t) == common);
+    EXPECT_TRUE(fibonacci_1 * s + fibonacci_0 * t == 1_bi);
+    
+    EXPECT_TRUE(big_int::xgcd(bigint_1, bigint_2, s, t) == 3_bi);
+    EXPECT_TRUE(bigint_1 * s + bigint_2 * t == 3_bi);
+    EXPECT_TRUE(s * 6_bi <= 0_bi - bigint_2 && s * big_int(-6) <= 0_bi - bigint_2);
+    
+    EXPECT_TRUE(big_int::xgcd(bigint_2, 0_bi, s, t) == 0_bi - bigint_2);
+    EXPECT_TRUE(s == big_int(-1) && t == 0_bi);
+    
+    EXPECT_TRUE(big_int(5).inverse_mod(common) * 5_bi % common == 1_bi);
+    EXPECT_THROW(big_int(3).inverse_mod(bigint_1), std::logic_error);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test16)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("3249832749832749832749832749832749832749827349872349");
+    big_int bigint_2("-9879879879879879879879879879879879879879879");
+    
+    EXPECT_TRUE((bigint_1 * bigint_2).divexact(bigint_2) == bigint_1);
+    EXPECT_TRUE((bigint_1 * bigint_2).divexact(bigint_1) == bigint_2);
+    EXPECT_TRUE((bigint_1 << 200).divexact(bigint_1 << 130) == 1_bi << 70);
+    EXPECT_TRUE(0_bi .divexact(bigint_2) == 0_bi);
+    EXPECT_THROW(bigint_1.divexact(0_bi), std::logic_error);
+    
+    // 3^20000 by 3^12000 is long enough for divide and conquer
+    big_int power = 1_bi;
+    for (int i = 0; i < 12000; ++i)
+    {
+        power *= 3_bi;
+    }
+    big_int quotient = power;
+    for (int i = 0; i < 8000; ++i)
+    {
+        power *= 3_bi;
+    }
+    
+    EXPECT_TRUE(power.divexact(quotient) == power / quotient);
+    EXPECT_TRUE(power.divexact_assign(power / quotient) == quotient);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test17)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("123456789abcdef0fedcba9876543210ff", 16);
+    big_int bigint_2("-9879879879879879879879879879879879879879879");
+    
+    std::array<std::byte, 20> bytes;
+    EXPECT_EQ(bigint_1.export_size(), 17u);
+    bigint_1.export_limbs(bytes, std::endian::big);
+    EXPECT_TRUE(bytes[0] == std::byte{0} && bytes[3] == std::byte{0x12} && bytes[19] == std::byte{0xff});
+    big_int imported;
+    EXPECT_TRUE(imported.import_limbs(bytes, std::endian::big) == bigint_1);
+    
+    bigint_2.export_limbs(bytes);
+    EXPECT_TRUE(imported.import_limbs(bytes, std::endian::little, false) == bigint_2);
+    EXPECT_THROW(bigint_1.export_limbs(std::span(bytes).first(16)), std::invalid_argument);
+    
+    std::stringstream stream;
+    bigint_1.write_binary(stream);
+    bigint_2.write_binary(stream);
+    0_bi .write_binary(stream);
+    EXPECT_EQ(stream.str().size(), 1u + 17u + 1u + 18u + 1u);
+    
+    big_int value_1, value_2, value_3 = 5_bi;
+    value_1.read_binary(stream);
+    value_2.read_binary(stream);
+    value_3.read_binary(stream);
+    EXPECT_TRUE(value_1 == bigint_1 && value_2 == bigint_2 && value_3 == 0_bi);
+    
+    std::stringstream truncated(stream.str().substr(0, 10));
+    EXPECT_TRUE(value_1.read_binary(truncated) == bigint_1 && truncated.fail());
+    
+    delete logger;
+}
+
+TEST(positive_tests, test18)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("3249832749832749832749832749832749832749827349872349");
+    big_int square = bigint_1 * bigint_1;
+    
+    EXPECT_TRUE(square.isqrt() == bigint_1);
+    EXPECT_TRUE((square - 1_bi).isqrt() == bigint_1 - 1_bi);
+    EXPECT_TRUE((square * bigint_1).iroot(3) == bigint_1);
+    EXPECT_TRUE((0_bi - square * bigint_1 + 1_bi).iroot(3) == 0_bi - bigint_1 + 1_bi);
+    EXPECT_TRUE(big_int(1000000).iroot(6) == 10_bi);
+    EXPECT_TRUE(99_bi .isqrt() == 9_bi && 0_bi .isqrt() == 0_bi);
+    
+    EXPECT_TRUE(square.is_perfect_square() && !(square + 1_bi).is_perfect_square());
+    EXPECT_TRUE((square * bigint_1).is_perfect_power() && !(square * 2_bi).is_perfect_power());
+    EXPECT_TRUE(big_int(-32).is_perfect_power() && !big_int(-4).is_perfect_power());
+    
+    EXPECT_THROW(big_int(-4).isqrt(), std::invalid_argument);
+    EXPECT_THROW(square.iroot(0), std::invalid_argument);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test19)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    std::vector<big_int> values;
+    big_int folded = 1_bi;
+    for (int i = 1; i <= 1000; ++i)
+    {
+        values.emplace_back(big_int(i) * big_int("9879879879879879879879879879879879879879879"));
+        folded *= values.back();
+    }
+    
+    EXPECT_TRUE(big_int::product(values) == folded);
+    EXPECT_TRUE(big_int::product(values, 4) == folded);
+    EXPECT_TRUE(big_int::product(std::vector<int>{2, 3, 7}) == 42_bi);
+    EXPECT_TRUE(big_int::product(std::vector<big_int>()) == 1_bi);
+    
+    big_int factorial = 1_bi;
+    for (int i = 2; i <= 300; ++i)
+    {
+        factorial *= big_int(i);
+    }
+    
+    EXPECT_TRUE(big_int::factorial(300) == factorial);
+    EXPECT_TRUE(big_int::factorial(0) == 1_bi && big_int::factorial(20) == big_int(2432902008176640000ull));
+    EXPECT_TRUE(big_int::binomial(300, 150) == factorial / (big_int::factorial(150) * big_int::factorial(150)));
+    EXPECT_TRUE(big_int::binomial(300, 3) == 4455100_bi);
+    EXPECT_TRUE(big_int::binomial(3, 5) == 0_bi && big_int::binomial(7, 0) == 1_bi);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test20)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    std::vector<bool> composite(20000, false);
+    for (size_t i = 2; i < composite.size(); ++i)
+    {
+        for (size_t j = 2 * i; j < composite.size(); j += i)
+        {
+            composite[j] = true;
+        }
+    }
+    
+    for (size_t i = 2; i < composite.size(); ++i)
+    {
+        EXPECT_EQ(big_int(i).is_probable_prime(), !composite[i]);
+    }
+    
+    EXPECT_FALSE(big_int(0).is_probable_prime() || big_int(1).is_probable_prime() || big_int(-7).is_probable_prime());
+    EXPECT_TRUE(((1_bi << 64) - 59_bi).is_probable_prime());
+    EXPECT_FALSE(big_int(3825123056546413051ull).is_probable_prime()); // strong pseudoprime to bases up to 23
+    
+    // composite Mersenne numbers without small factors pass Miller-Rabin to base 2, Lucas test rejects them
+    big_int m61 = (1_bi << 61) - 1_bi, m89 = (1_bi << 89) - 1_bi, m127 = (1_bi << 127) - 1_bi, m67 = (1_bi << 67) - 1_bi;
+    EXPECT_TRUE(m67.is_probable_prime(1));
+    EXPECT_FALSE(m67.is_probable_prime(1, big_int::primality_test::BPSW));
+    EXPECT_FALSE(m67.is_probable_prime());
+    EXPECT_TRUE(m127.is_probable_prime() && m127.is_probable_prime(1, big_int::primality_test::BPSW));
+    EXPECT_FALSE((m61 * m89).is_probable_prime(1, big_int::primality_test::BPSW));
+    EXPECT_FALSE((m89 * m127).is_probable_prime());
+    
+    std::mt19937_64 generator(7);
+    big_int bound = 1_bi << 200;
+    for (int i = 0; i < 100; ++i)
+    {
+        big_int value = big_int::random_bits(200, generator);
+        EXPECT_TRUE(value >= 0_bi && value < bound);
+        EXPECT_TRUE(big_int::random_below(m89, generator) < m89);
+    }
+    
+    EXPECT_THROW(big_int::random_below(0_bi, generator), std::invalid_argument);
+    
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
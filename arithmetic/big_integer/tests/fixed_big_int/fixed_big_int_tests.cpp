@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <fixed_big_int.h>
+#include <client_logger.h>
+#include <client_logger_builder.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+
+    logger *built_logger = builder->build();
+
+    delete builder;
+
+    return built_logger;
+}
+
+using int256 = fixed_big_int<256>;
+
+// evaluated at compile time
+static_assert(int256(1) << 255 == -(int256(1) << 255));
+static_assert((int256(-7) / int256(2)) == int256(-3) && (int256(-7) % int256(2)) == int256(-1));
+static_assert(int256(-1) >> 100 == int256(-1) && int256(-1) < int256(0));
+static_assert(std::is_same_v<decltype(0xffff'ffff'ffff'ffff_fbi), fixed_big_int<128>>);
+static_assert(std::is_same_v<decltype(123_fbi), fixed_big_int<64>>);
+static_assert(340282366920938463463374607431768211455_fbi + 1_fbi == int256(1) << 128);
+static_assert(int256("-123456789012345678901234567890") * 10_fbi == int256("-1234567890123456789012345678900"));
+
+fixed_big_int<512> make_operand(unsigned int seed)
+{
+    fixed_big_int<512> res;
+
+    for (unsigned int i = 0; i < 8; ++i)
+        res = (res << 64) | fixed_big_int<512>(static_cast<unsigned long long>(seed + i) * 0x9e3779b97f4a7c15ull);
+
+    return res >> (seed % 400);
+}
+
+TEST(positive_tests_fixed, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    int256 value("-28958888309635818123456789012345678901234567890");
+
+    EXPECT_EQ(value.to_string(), "-28958888309635818123456789012345678901234567890");
+    EXPECT_TRUE(static_cast<big_int>(value) == big_int("-28958888309635818123456789012345678901234567890"));
+    EXPECT_TRUE(int256(big_int("-28958888309635818123456789012345678901234567890")) == value);
+    EXPECT_TRUE(int256(big_int(1) << 300) == int256(0));
+
+    std::ostringstream stream;
+    stream << 0x1234_fbi;
+    EXPECT_EQ(stream.str(), "4660");
+
+    EXPECT_THROW(int256("12a"), std::invalid_argument);
+    EXPECT_THROW(value / int256(0), std::logic_error);
+
+    delete logger;
+}
+
+TEST(positive_tests_fixed, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    // results are compared with big_int modulo 2^512
+    big_int modulus = big_int(1) << 512;
+
+    auto wrap = [&](big_int value)
+    {
+        value %= modulus;
+        if (value < 0_bi)
+            value += modulus;
+        if (value >= modulus >> 1)
+            value -= modulus;
+        return value;
+    };
+
+    for (unsigned int i = 0; i < 200; ++i)
+    {
+        fixed_big_int<512> a = make_operand(i), b = make_operand(7 * i + 3);
+
+        if (i % 3 == 0)
+            b = -b;
+
+        big_int x = static_cast<big_int>(a), y = static_cast<big_int>(b);
+
+        EXPECT_TRUE(static_cast<big_int>(a + b) == wrap(x + y));
+        EXPECT_TRUE(static_cast<big_int>(a - b) == wrap(x - y));
+        EXPECT_TRUE(static_cast<big_int>(a * b) == wrap(x * y));
+        EXPECT_TRUE(static_cast<big_int>(a / b) == x / y);
+        EXPECT_TRUE(static_cast<big_int>(a % b) == x % y);
+        EXPECT_EQ(a < b, x < y);
+    }
+
+    delete logger;
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <rns_int.h>
+#include <client_logger.h>
+#include <client_logger_builder.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+
+    logger *built_logger = builder->build();
+
+    delete builder;
+
+    return built_logger;
+}
+
+big_int make_operand(unsigned int seed, size_t bits)
+{
+    big_int res;
+
+    for (size_t i = 0; i * 64 < bits; ++i)
+        res = (res << 64) + big_int(static_cast<long long>(((seed + i) * 0x9e3779b97f4a7c15ull) >> 1));
+
+    res >>= (bits + 63) / 64 * 64 - bits + 1 + seed % 32;
+
+    return seed % 2 == 0 ? res : 0_bi - res;
+}
+
+TEST(positive_tests_rns, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    for (size_t bits : {1, 61, 62, 200, 1000})
+    {
+        auto basis = std::make_shared<const rns_basis>(bits);
+
+        EXPECT_TRUE(basis->product() > big_int(1) << (bits + 1));
+
+        for (unsigned int i = 0; i < 20; ++i)
+        {
+            big_int a = make_operand(i, bits), b = make_operand(5 * i + 1, bits / 2 + 1), c = make_operand(3 * i + 2, bits / 2 + 1);
+            rns_int x(a, basis);
+
+            EXPECT_TRUE(x.to_big_int() == a);
+
+            big_int residue = a % big_int(static_cast<long long>(basis->prime(0)));
+            if (residue < 0_bi)
+                residue += big_int(static_cast<long long>(basis->prime(0)));
+            EXPECT_TRUE(big_int(static_cast<long long>(x.residue(0))) == residue);
+
+            EXPECT_TRUE(static_cast<big_int>(rns_int(b, basis) * rns_int(c, basis)) == b * c);
+            EXPECT_TRUE(static_cast<big_int>(x + rns_int(b, basis) - rns_int(c, basis)) == a + b - c);
+        }
+    }
+
+    EXPECT_THROW(rns_basis(0), std::invalid_argument);
+    EXPECT_THROW(rns_int(1_bi, std::make_shared<const rns_basis>(10)) + rns_int(1_bi, std::make_shared<const rns_basis>(10)), std::invalid_argument);
+
+    delete logger;
+}
+
+TEST(positive_tests_rns, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    // dot product leaves the range in between, only the sum has to fit
+    auto basis = std::make_shared<const rns_basis>(2100);
+    rns_int sum(basis);
+    big_int expected;
+
+    for (unsigned int i = 0; i < 300; ++i)
+    {
+        big_int a = make_operand(i, 1000), b = make_operand(2 * i + 7, 1000);
+
+        sum.multiply_add(rns_int(a, basis), rns_int(b, basis));
+        expected += a * b;
+    }
+
+    EXPECT_TRUE(sum.to_big_int() == expected);
+
+    delete logger;
+}
+
+TEST(positive_tests_rns, test3)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                       {
+                                           {
+                                               "bigint_logs.txt",
+                                               logger::severity::information
+                                           },
+                                       });
+
+    // residue ranges on pool threads give the same residues as one loop
+    auto basis = std::make_shared<const rns_basis>(4000);
+    big_int a = make_operand(3, 2000), b = make_operand(8, 1900), c = make_operand(11, 3000);
+
+    rns_int x(a, basis), y(b, basis), sum(basis);
+    sum.multiply_add(x, y);
+
+    size_t parallelism = big_int::parallelism, threshold = big_int::parallel_threshold;
+    big_int::parallelism = 4;
+    big_int::parallel_threshold = 1;
+
+    rns_int px(a, basis), py(b, basis), pz(c, basis), psum(basis);
+    psum.multiply_add(px, py);
+
+    for (size_t j = 0; j < basis->size(); ++j)
+        EXPECT_EQ(px.residue(j), x.residue(j));
+
+    EXPECT_TRUE(static_cast<big_int>(px * py) == a * b);
+    EXPECT_TRUE(static_cast<big_int>(px + pz - py) == a + c - b);
+    EXPECT_TRUE(psum.to_big_int() == sum.to_big_int());
+
+    big_int::parallelism = parallelism;
+    big_int::parallel_threshold = threshold;
+
+    delete logger;
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+#include <big_float.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <string>
+
+/** Prints time of same computations on fraction and on big_float of precision matching given digits. Iterations keep
+ *  fraction exact, so its parts grow with every step, while big_float stays at precision; transcendental functions
+ *  share kernels and should take about the same time.
+ *  Usage: mp_os_arthmtc_frctn_bnchmrks_bg_flt [digits], default is 1000 digits
+ */
+
+namespace
+{
+    double milliseconds_since(std::chrono::steady_clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    template<class Fraction, class Float>
+    void compare(const char *name, const Fraction &on_fraction, const Float &on_float)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        on_fraction();
+        double fraction_time = milliseconds_since(begin);
+
+        begin = std::chrono::steady_clock::now();
+        on_float();
+        double float_time = milliseconds_since(begin);
+
+        std::cout << std::setw(28) << name << ": fraction " << std::setw(10) << fraction_time << " ms, big_float "
+                  << std::setw(10) << float_time << " ms, speedup " << fraction_time / float_time << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t digits = argc > 1 ? std::stoul(argv[1]) : 1000;
+    size_t precision = static_cast<size_t>(static_cast<double>(digits) * 3.3219280948873623) + 1;
+    std::string scale(digits + 1, '0');
+    scale[0] = '1';
+    fraction epsilon(1_bi, big_int(scale));
+
+    std::cout << digits << " digits, " << precision << " bits:" << std::endl << std::fixed << std::setprecision(3);
+
+    // Newton's iteration for sqrt(2) doubles correct digits and length of exact parts
+    size_t newton_steps = 2;
+
+    while ((size_t(1) << newton_steps) < precision)
+        ++newton_steps;
+
+    compare("sqrt(2) by Newton", [&]
+    {
+        fraction x(1_bi, 1_bi), two(2_bi, 1_bi);
+
+        for (size_t i = 0; i < newton_steps; ++i)
+            x = (x + two / x) / two;
+    }, [&]
+    {
+        big_float x(1_bi, precision), two(2_bi, precision);
+
+        for (size_t i = 0; i < newton_steps; ++i)
+            x = (x + two / x) / two;
+    });
+
+    // logistic map doubles length of exact value every step
+    compare("logistic map, 18 steps", []
+    {
+        fraction x(1_bi, 3_bi), r(37_bi, 10_bi), one(1_bi, 1_bi);
+
+        for (size_t i = 0; i < 18; ++i)
+            x = r * x * (one - x);
+    }, [&]
+    {
+        big_float x(fraction(1_bi, 3_bi), precision), r(fraction(37_bi, 10_bi), precision), one(1_bi, precision);
+
+        for (size_t i = 0; i < 18; ++i)
+            x = r * x * (one - x);
+    });
+
+    compare("sum of 1/k!, 450 terms", []
+    {
+        fraction sum, term(1_bi, 1_bi);
+
+        for (size_t k = 1; k <= 450; ++k)
+        {
+            sum += term;
+            term /= fraction(big_int(k), 1_bi);
+        }
+    }, [&]
+    {
+        big_float sum(precision), term(1_bi, precision);
+
+        for (size_t k = 1; k <= 450; ++k)
+        {
+            sum += term;
+            term /= big_float(big_int(k), precision);
+        }
+    });
+
+    fraction x(1_bi, 3_bi);
+    big_float y(x, precision);
+
+    compare("sin(1/3)", [&] { x.sin(epsilon); }, [&] { y.sin(); });
+    compare("ln(1/3)", [&] { x.ln(epsilon); }, [&] { y.ln(); });
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <fraction.h>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <string>
+
+/** Prints time of long sums and products under every normalization policy, manual one is reduced once at the end.
+ *  Usage: mp_os_arthmtc_frctn_bnchmrks_nrmlztn [terms], default is 1000 terms
+ */
+
+namespace
+{
+    struct workload
+    {
+        const char *name;
+        std::function<fraction(size_t)> run;
+    };
+
+    fraction harmonic_sum(size_t terms)
+    {
+        fraction sum;
+
+        for (size_t k = 1; k <= terms; ++k)
+            sum += fraction(1_bi, big_int(k));
+
+        return sum;
+    }
+
+    fraction exponent_series(size_t terms)
+    {
+        fraction sum, term(1_bi, 1_bi);
+
+        for (size_t k = 1; k <= terms; ++k)
+        {
+            sum += term;
+            term /= fraction(big_int(k), 1_bi);
+        }
+
+        return sum;
+    }
+
+    fraction random_sum(size_t terms)
+    {
+        std::mt19937_64 generator(42);
+        std::uniform_int_distribution<long long> distribution(1, 1000);
+        fraction sum;
+
+        for (size_t k = 0; k < terms; ++k)
+            sum += fraction(big_int(distribution(generator)), big_int(distribution(generator)));
+
+        return sum;
+    }
+
+    fraction telescoping_product(size_t terms)
+    {
+        fraction product(1_bi, 1_bi);
+
+        for (size_t k = 1; k <= terms; ++k)
+            product *= fraction(big_int(k + 1), big_int(k));
+
+        return product;
+    }
+
+    fraction wallis_product(size_t terms)
+    {
+        fraction product(1_bi, 1_bi);
+
+        for (size_t k = 1; k <= terms; ++k)
+            product *= fraction(big_int(4 * k * k), big_int(4 * k * k - 1));
+
+        return product;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t terms = argc > 1 ? std::stoul(argv[1]) : 1000;
+
+    const workload workloads[] = {
+        {"harmonic sum", harmonic_sum},
+        {"exponent series", exponent_series},
+        {"random sum", random_sum},
+        {"telescoping product", telescoping_product},
+        {"Wallis product", wallis_product}
+    };
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (const auto &[name, run]: workloads)
+    {
+        std::cout << name << ", " << terms << " terms:" << std::endl;
+
+        fraction expected;
+        double eager_time = 0;
+
+        for (auto [policy, policy_name]: {std::pair{fraction::normalization_policy::eager, "eager"},
+                                          std::pair{fraction::normalization_policy::lazy, "lazy"},
+                                          std::pair{fraction::normalization_policy::manual, "manual"}})
+        {
+            fraction::normalization = policy;
+
+            auto begin = std::chrono::steady_clock::now();
+            fraction res = run(terms);
+            res.normalize();
+            double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+            if (policy == fraction::normalization_policy::eager)
+            {
+                expected = res;
+                eager_time = time;
+            } else if (!(res == expected))
+            {
+                std::cout << "  " << policy_name << ": result differs" << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            std::cout << "  " << std::setw(6) << policy_name << ": " << std::setw(10) << time << " ms, speedup " << eager_time / time << std::endl;
+        }
+    }
+
+    fraction::normalization = fraction::normalization_policy::eager;
+    return 0;
+}
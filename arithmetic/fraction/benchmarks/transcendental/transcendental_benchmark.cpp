@@ -0,0 +1,63 @@
+#include <fraction.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <string>
+
+/** Prints time of sin, cos and ln at fixed precision over arguments of growing magnitude and length, so spread
+ *  between fastest and slowest argument is visible. First call of each row also fills cache of pi.
+ *  Usage: mp_os_arthmtc_frctn_bnchmrks_trnscndntl [digits], default is 1000 digits
+ */
+
+namespace
+{
+    struct argument
+    {
+        const char *name;
+        fraction value;
+    };
+
+    big_int power_of_ten(size_t exponent)
+    {
+        return big_int("1" + std::string(exponent, '0'));
+    }
+
+    double milliseconds_since(std::chrono::steady_clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t digits = argc > 1 ? std::stoul(argv[1]) : 1000;
+    fraction epsilon(1_bi, power_of_ten(digits));
+
+    const argument arguments[] = {
+        {"1/3", fraction(1_bi, 3_bi)},
+        {"10", fraction(10_bi, 1_bi)},
+        {"1000/7", fraction(1000_bi, 7_bi)},
+        {"2^24/3", fraction(1_bi << 24, 3_bi)},
+        {"10^30/3", fraction(power_of_ten(30), 3_bi)},
+        {"10^300/7", fraction(power_of_ten(300), 7_bi)},
+        {"200 digits / 10^200", fraction(big_int("3" + std::string(200, '1')), power_of_ten(200))}
+    };
+
+    std::cout << digits << " digits, ms:" << std::endl << std::fixed << std::setprecision(3);
+
+    for (const auto &[name, value]: arguments)
+    {
+        std::cout << std::setw(20) << name;
+
+        for (auto [function, function_name]: {std::pair{&fraction::sin, "sin"}, std::pair{&fraction::cos, "cos"}, std::pair{&fraction::ln, "ln"}})
+        {
+            auto begin = std::chrono::steady_clock::now();
+            (value.*function)(epsilon);
+            std::cout << "  " << function_name << " " << std::setw(10) << milliseconds_since(begin);
+        }
+
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
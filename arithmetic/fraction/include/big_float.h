@@ -0,0 +1,157 @@
+#ifndef MP_OS_BIG_FLOAT_H
+#define MP_OS_BIG_FLOAT_H
+
+#include <fraction.h>
+#include <compare>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/** Binary floating point value mantissa * 2^exponent with mantissa of at most precision bits. Unlike fraction, size
+ *  of values stays bounded by precision however long computation runs. Arithmetic, sqrt and transcendental functions
+ *  are rounded correctly in rounding mode of left operand and take its precision. Transcendental functions share
+ *  fixed point kernels with fraction and raise their precision until error bound decides rounding
+ */
+class big_float final
+{
+public:
+
+    enum class rounding_mode
+    {
+        to_nearest, // ties to even
+        toward_zero,
+        upward,
+        downward
+    };
+
+private:
+
+    big_int _mantissa; // odd or zero, below 2^_precision in magnitude
+    std::int64_t _exponent; // zero for zero value
+    size_t _precision;
+    rounding_mode _rounding;
+
+    /** Sets value (-1)^negative * (magnitude + tail) * 2^exponent rounded to precision, where tail in (0, 1)
+     *  is present when sticky is set. Sticky needs magnitude longer than precision
+     */
+    void assign(bool negative, big_int magnitude, std::int64_t exponent, bool sticky);
+
+    /** Correctly rounded value whose fixed(bits) gives value * 2^bits off by less than 2.
+     *  Never ends for values with finite binary expansion, so callers handle them first
+     */
+    template<class Fixed>
+    static big_float round_fixed(const Fixed &fixed, size_t precision, rounding_mode rounding);
+
+    /** Precision whose unit of last place at value is at most epsilon
+     */
+    static size_t precision_for(const fraction &value, const fraction &epsilon);
+
+    static size_t bit_length(const big_int &value) noexcept;
+
+    static size_t trailing_zeros(const big_int &value) noexcept;
+
+public:
+
+    /** Zero
+     *  @throws std::invalid_argument if precision is zero
+     */
+    explicit big_float(size_t precision = 64, rounding_mode rounding = rounding_mode::to_nearest);
+
+    big_float(const big_int &value, size_t precision, rounding_mode rounding = rounding_mode::to_nearest);
+
+    /** mantissa * 2^exponent rounded to precision
+     */
+    big_float(const big_int &mantissa, std::int64_t exponent, size_t precision, rounding_mode rounding = rounding_mode::to_nearest);
+
+    big_float(const fraction &value, size_t precision, rounding_mode rounding = rounding_mode::to_nearest);
+
+    /** Precision is chosen so that value is off by at most epsilon
+     *  @throws std::invalid_argument if epsilon is not positive
+     */
+    big_float(const fraction &value, const fraction &epsilon, rounding_mode rounding = rounding_mode::to_nearest);
+
+    size_t precision() const noexcept;
+
+    rounding_mode rounding() const noexcept;
+
+    const big_int &mantissa() const noexcept;
+
+    std::int64_t exponent() const noexcept;
+
+    /** Same value rounded to other precision and mode
+     */
+    big_float rounded(size_t precision, rounding_mode rounding) const;
+
+    /** Exact value
+     */
+    fraction to_fraction() const;
+
+    /** Nearest multiple of largest power of two not above epsilon, shorter than exact value
+     *  @throws std::invalid_argument if epsilon is not positive
+     */
+    fraction to_fraction(const fraction &epsilon) const;
+
+    explicit operator fraction() const;
+
+public:
+
+    big_float &operator+=(const big_float &other) &;
+
+    big_float operator+(const big_float &other) const;
+
+    big_float &operator-=(const big_float &other) &;
+
+    big_float operator-(const big_float &other) const;
+
+    big_float &operator*=(const big_float &other) &;
+
+    big_float operator*(const big_float &other) const;
+
+    /** @throws std::logic_error if other is zero
+     */
+    big_float &operator/=(const big_float &other) &;
+
+    big_float operator/(const big_float &other) const;
+
+public:
+
+    /** Compare exact values regardless of precision and mode
+     */
+    bool operator==(const big_float &other) const noexcept;
+
+    std::strong_ordering operator<=>(const big_float &other) const noexcept;
+
+public:
+
+    /** Decimal scientific notation with as many significant digits as precision holds
+     */
+    friend std::ostream &operator<<(std::ostream &stream, const big_float &value);
+
+    std::string to_string() const;
+
+public:
+
+    /** @throws std::invalid_argument if value is negative
+     */
+    big_float sqrt() const;
+
+    /** @throws std::out_of_range if exponent of result does not fit in int64
+     */
+    big_float exp() const;
+
+    /** @throws std::invalid_argument if value is not positive
+     */
+    big_float ln() const;
+
+    big_float sin() const;
+
+    big_float cos() const;
+
+    big_float tg() const;
+
+    big_float arctg() const;
+
+    static big_float pi(size_t precision, rounding_mode rounding = rounding_mode::to_nearest);
+};
+
+#endif //MP_OS_BIG_FLOAT_H
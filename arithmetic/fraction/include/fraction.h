@@ -4,16 +4,124 @@
 #include <big_int.h>
 #include <not_implemented.h>
 #include <concepts>
+#include <cstdint>
 
 class fraction final
 {
 
+public:
+
+    enum class normalization_policy
+    {
+        eager, // gcd after every operation
+        lazy, // operands below normalization_threshold limbs are combined without gcd, result is reduced
+              // when it passes normalization_threshold limbs and twice its size after last reduction
+        manual // gcd only in normalize()
+    };
+
+    static inline normalization_policy normalization = normalization_policy::eager;
+    static inline size_t normalization_threshold = 16;
+
 private:
 
+    // fractions with both parts in int64 live in _small_numerator / _small_denominator and big_int parts stay zero.
+    // Arithmetic on them is overflow checked and moves to big_int only when result does not fit.
+    // Numerator never equals INT64_MIN, so negation is always safe; denominator is positive
+    bool _small;
+    std::int64_t _small_numerator;
+    std::int64_t _small_denominator;
     big_int _numerator;
     big_int _denominator;
+    bool _reduced; // big parts are coprime; small ones always are
+    size_t _reduced_limbs; // size of longer big part after last reduction
+
+    void optimise(); //сокращает дробь по normalization, возвращает к int64 если помещается
+
+    /** gcd reduction of big parts
+     */
+    void reduce();
+
+    /** Moves big parts to small representation if they fit
+     */
+    bool demote();
+
+    /** true if policy reduces result of operation with numerator / denominator right away
+     */
+    static bool exact_arithmetic(const big_int &numerator, const big_int &denominator) noexcept;
+
+    /** Big path of arithmetic with numerator / denominator (positive denominator). When exact_arithmetic holds and
+     *  both operands are reduced, result is reduced by gcds of operand size, otherwise parts are multiplied and
+     *  optimise decides
+     */
+    void add_big(big_int numerator, big_int denominator, bool reduced);
+
+    void multiply_big(big_int numerator, big_int denominator, bool reduced);
+
+    /** Moves small representation to big_int parts
+     */
+    void promote();
+
+    big_int big_numerator() const;
+
+    big_int big_denominator() const;
 
-    void optimise(); //сокращает дробь
+    /** true and value in res if value is in (INT64_MIN, INT64_MAX]
+     */
+    static bool fits_small(const big_int &value, std::int64_t &res) noexcept;
+
+    /** log2 |value|, -infinity for zero
+     */
+    static double log2_magnitude(const big_int &value) noexcept;
+
+    /** Smallest bits with 2^-bits <= epsilon
+     *  @throws std::invalid_argument if epsilon is not positive
+     */
+    static size_t precision_bits(fraction const &epsilon);
+
+    /** Fixed point evaluations: function times 2^bits, off by less than 2. Series are summed by binary splitting
+     *  with term count found from bits in advance
+     */
+    big_int sin_fixed(size_t bits) const;
+
+    big_int cos_fixed(size_t bits) const;
+
+    /** sin or cos after reduction by angle halving or modulo pi/2
+     */
+    big_int trig_fixed(size_t bits, bool cosine) const;
+
+    /** sin and cos of angle / 2^scale times 2^bits for |angle / 2^scale| <= 1, angle is split in chunks of
+     *  doubling length whose series stay short and joined by addition formulas
+     */
+    static void sin_cos_fixed(big_int angle, size_t scale, size_t bits, big_int &sin, big_int &cos);
+
+    /** ln(value / 2^scale) times 2^bits for value / 2^scale in [1/2, 2], value is divided by its leading chunks
+     *  of doubling length, each of short logarithm series, until rest is close to 1
+     */
+    static big_int ln_fixed(big_int value, size_t scale, size_t bits);
+
+    big_int tg_fixed(size_t bits) const;
+
+    big_int arctg_fixed(size_t bits) const;
+
+    big_int ln_fixed(size_t bits) const;
+
+    /** exp(x - k ln 2) times 2^bits with k = round(x / ln 2), so exp(x) = result * 2^(k - bits)
+     *  @throws std::out_of_range if k does not fit in int64
+     */
+    big_int exp_fixed(size_t bits, std::int64_t &k) const;
+
+    /** exp(value / 2^scale) times 2^bits for |value / 2^scale| <= 1, product over chunks of doubling length
+     */
+    static big_int exp_fixed(big_int value, size_t scale, size_t bits);
+
+    /** Cached at the longest precision requested so far
+     */
+    static big_int pi_fixed(size_t bits);
+
+    static big_int ln2_fixed(size_t bits);
+
+    // rounds results of the fixed point evaluations above
+    friend class big_float;
 
 public:
 
@@ -24,6 +132,11 @@ public:
 
     fraction(pp_allocator<big_int::value_type> = pp_allocator<big_int::value_type>());
 
+    /** Reduces fraction regardless of normalization policy. Comparison and output are correct without it,
+     *  lazy and manual policies only let parts carry common factors between calls
+     */
+    fraction &normalize() &;
+
 public:
 
     fraction &operator+=(fraction const &other) &;
@@ -100,4 +213,12 @@ public:
 
 };
 
+template<std::convertible_to<big_int> f, std::convertible_to<big_int> s>
+fraction::fraction(f &&numerator, s &&denominator) : _small(false), _small_numerator(0), _small_denominator(1),
+                                                     _numerator(std::forward<f>(numerator)), _denominator(std::forward<s>(denominator)),
+                                                     _reduced(false), _reduced_limbs(0)
+{
+    optimise();
+}
+
 #endif //MP_OS_FRACTION_H
\ No newline at end of file
@@ -0,0 +1,546 @@
+#include "../include/big_float.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    /** Extra bits of first fixed point evaluation, error of 2 units below them rarely touches rounding
+     */
+    constexpr size_t ziv_guard_bits = 32;
+
+    big_int magnitude(const big_int &value)
+    {
+        return value < 0_bi ? 0_bi - value : value;
+    }
+
+    big_int power_of_ten(size_t exponent)
+    {
+        big_int res = 1_bi, base = 10_bi;
+
+        for (; exponent != 0; exponent >>= 1)
+        {
+            if (exponent & 1)
+                res *= base;
+            base *= base;
+        }
+
+        return res;
+    }
+}
+
+size_t big_float::bit_length(const big_int &value) noexcept
+{
+    const auto &digits = value._digits;
+
+    if (digits.empty())
+        return 0;
+
+    return 64 * (digits.size() - 1) + static_cast<size_t>(std::bit_width(digits[digits.size() - 1]));
+}
+
+size_t big_float::trailing_zeros(const big_int &value) noexcept
+{
+    const auto &digits = value._digits;
+    size_t i = 0;
+
+    while (i < digits.size() && digits[i] == 0)
+        ++i;
+
+    return i == digits.size() ? 0 : 64 * i + static_cast<size_t>(std::countr_zero(digits[i]));
+}
+
+void big_float::assign(bool negative, big_int magnitude, std::int64_t exponent, bool sticky)
+{
+    size_t length = bit_length(magnitude);
+
+    if (length > _precision)
+    {
+        size_t drop = length - _precision;
+        big_int kept = magnitude >> drop;
+        big_int rest = magnitude - (kept << drop);
+        bool inexact = sticky || rest != 0_bi;
+        bool up = false;
+
+        switch (_rounding)
+        {
+            case rounding_mode::to_nearest:
+            {
+                big_int half = 1_bi << (drop - 1);
+                up = rest > half || (rest == half && (sticky || (kept._digits[0] & 1) != 0));
+                break;
+            }
+            case rounding_mode::toward_zero:
+                break;
+            case rounding_mode::upward:
+                up = inexact && !negative;
+                break;
+            case rounding_mode::downward:
+                up = inexact && negative;
+                break;
+        }
+
+        if (up)
+            kept += 1_bi;
+
+        magnitude = std::move(kept);
+        exponent += static_cast<std::int64_t>(drop);
+    }
+
+    if (magnitude == 0_bi)
+    {
+        _mantissa = 0_bi;
+        _exponent = 0;
+        return;
+    }
+
+    size_t zeros = trailing_zeros(magnitude);
+    magnitude >>= zeros;
+
+    _exponent = exponent + static_cast<std::int64_t>(zeros);
+    _mantissa = negative ? 0_bi - magnitude : std::move(magnitude);
+}
+
+template<class Fixed>
+big_float big_float::round_fixed(const Fixed &fixed, size_t precision, rounding_mode rounding)
+{
+    size_t bits = precision + ziv_guard_bits;
+
+    for (;;)
+    {
+        big_int value = fixed(bits);
+        size_t length = bit_length(value);
+
+        if (length < precision + ziv_guard_bits)
+        {
+            // small value: bits grow by its leading zeros, or double while it is lost in error
+            bits += length > 2 ? precision + ziv_guard_bits - length : bits;
+            continue;
+        }
+
+        std::int64_t exponent = -static_cast<std::int64_t>(bits);
+        big_float low(value - 2_bi, exponent, precision, rounding), high(value + 2_bi, exponent, precision, rounding);
+
+        if (low == high)
+            return low;
+
+        bits += bits / 2;
+    }
+}
+
+big_float::big_float(size_t precision, rounding_mode rounding) : _mantissa(0_bi), _exponent(0), _precision(precision), _rounding(rounding)
+{
+    if (precision == 0)
+        throw std::invalid_argument("big_float: precision must be positive");
+}
+
+big_float::big_float(const big_int &value, size_t precision, rounding_mode rounding) : big_float(value, 0, precision, rounding)
+{
+
+}
+
+big_float::big_float(const big_int &mantissa, std::int64_t exponent, size_t precision, rounding_mode rounding) : big_float(precision, rounding)
+{
+    assign(mantissa < 0_bi, magnitude(mantissa), exponent, false);
+}
+
+big_float::big_float(const fraction &value, size_t precision, rounding_mode rounding) : big_float(precision, rounding)
+{
+    big_int numerator = value.big_numerator(), denominator = value.big_denominator();
+
+    if (numerator == 0_bi)
+        return;
+
+    bool negative = numerator < 0_bi;
+    numerator = magnitude(numerator);
+
+    // quotient of precision + 2 bits at least, remainder sets sticky bit
+    std::int64_t shift = static_cast<std::int64_t>(precision + 2 + bit_length(denominator)) - static_cast<std::int64_t>(bit_length(numerator));
+
+    if (shift > 0)
+        numerator <<= static_cast<size_t>(shift);
+    else
+        denominator <<= static_cast<size_t>(-shift);
+
+    big_int quotient = numerator / denominator;
+    bool sticky = quotient * denominator != numerator;
+
+    assign(negative, std::move(quotient), -shift, sticky);
+}
+
+big_float::big_float(const fraction &value, const fraction &epsilon, rounding_mode rounding) : big_float(value, precision_for(value, epsilon), rounding)
+{
+
+}
+
+size_t big_float::precision_for(const fraction &value, const fraction &epsilon)
+{
+    size_t bits = fraction::precision_bits(epsilon);
+    double log2_value = fraction::log2_magnitude(value.big_numerator()) - fraction::log2_magnitude(value.big_denominator());
+
+    if (std::isinf(log2_value))
+        return 1;
+
+    // unit of last place 2^(floor(log2 |value|) + 1 - precision) stays within 2^-bits
+    std::int64_t precision = static_cast<std::int64_t>(bits) + static_cast<std::int64_t>(std::ceil(log2_value)) + 1;
+    return precision > 0 ? static_cast<size_t>(precision) : 1;
+}
+
+size_t big_float::precision() const noexcept
+{
+    return _precision;
+}
+
+big_float::rounding_mode big_float::rounding() const noexcept
+{
+    return _rounding;
+}
+
+const big_int &big_float::mantissa() const noexcept
+{
+    return _mantissa;
+}
+
+std::int64_t big_float::exponent() const noexcept
+{
+    return _exponent;
+}
+
+big_float big_float::rounded(size_t precision, rounding_mode rounding) const
+{
+    return big_float(_mantissa, _exponent, precision, rounding);
+}
+
+fraction big_float::to_fraction() const
+{
+    if (_exponent >= 0)
+        return fraction(_mantissa << static_cast<size_t>(_exponent), 1_bi);
+
+    return fraction(_mantissa, 1_bi << static_cast<size_t>(-_exponent));
+}
+
+fraction big_float::to_fraction(const fraction &epsilon) const
+{
+    // precision_bits keeps a spare bit for logarithms, 2^-(bits - 1) is already within epsilon
+    size_t bits = fraction::precision_bits(epsilon) - 1;
+
+    if (_exponent >= -static_cast<std::int64_t>(bits))
+        return to_fraction();
+
+    // nearest multiple of 2^-bits is off by 2^-(bits + 1) at most
+    size_t drop = static_cast<size_t>(-_exponent) - bits;
+    big_int rounded = (magnitude(_mantissa) + (1_bi << (drop - 1))) >> drop;
+
+    return fraction(_mantissa < 0_bi ? 0_bi - rounded : rounded, 1_bi << bits);
+}
+
+big_float::operator fraction() const
+{
+    return to_fraction();
+}
+
+big_float &big_float::operator+=(const big_float &other) &
+{
+    if (other._mantissa == 0_bi)
+        return *this;
+
+    if (_mantissa == 0_bi)
+    {
+        assign(other._mantissa < 0_bi, magnitude(other._mantissa), other._exponent, false);
+        return *this;
+    }
+
+    // a is operand with higher leading bit
+    bool a_negative = _mantissa < 0_bi, b_negative = other._mantissa < 0_bi;
+    big_int a = magnitude(_mantissa), b = magnitude(other._mantissa);
+    std::int64_t a_exponent = _exponent, b_exponent = other._exponent;
+
+    if (b_exponent + static_cast<std::int64_t>(bit_length(b)) > a_exponent + static_cast<std::int64_t>(bit_length(a)))
+    {
+        std::swap(a, b);
+        std::swap(a_negative, b_negative);
+        std::swap(a_exponent, b_exponent);
+    }
+
+    // b below unit of a * 2^guard only moves it by less than one unit, so it is kept as sticky bit
+    std::int64_t guard = static_cast<std::int64_t>(_precision) + 2;
+
+    if (b_exponent + static_cast<std::int64_t>(bit_length(b)) <= a_exponent - guard)
+    {
+        big_int shifted = a << static_cast<size_t>(guard);
+
+        if (a_negative != b_negative)
+            shifted -= 1_bi;
+
+        assign(a_negative, std::move(shifted), a_exponent - guard, true);
+        return *this;
+    }
+
+    std::int64_t exponent = std::min(a_exponent, b_exponent);
+    a <<= static_cast<size_t>(a_exponent - exponent);
+    b <<= static_cast<size_t>(b_exponent - exponent);
+
+    if (a_negative == b_negative)
+        assign(a_negative, a + b, exponent, false);
+    else if (a >= b)
+        assign(a_negative, a - b, exponent, false);
+    else
+        assign(b_negative, b - a, exponent, false);
+
+    return *this;
+}
+
+big_float big_float::operator+(const big_float &other) const
+{
+    big_float res(*this);
+    res += other;
+    return res;
+}
+
+big_float &big_float::operator-=(const big_float &other) &
+{
+    big_float negated(other);
+    negated._mantissa = 0_bi - negated._mantissa;
+    return *this += negated;
+}
+
+big_float big_float::operator-(const big_float &other) const
+{
+    big_float res(*this);
+    res -= other;
+    return res;
+}
+
+big_float &big_float::operator*=(const big_float &other) &
+{
+    if (_mantissa == 0_bi || other._mantissa == 0_bi)
+    {
+        assign(false, 0_bi, 0, false);
+        return *this;
+    }
+
+    bool negative = (_mantissa < 0_bi) != (other._mantissa < 0_bi);
+    assign(negative, magnitude(_mantissa) * magnitude(other._mantissa), _exponent + other._exponent, false);
+    return *this;
+}
+
+big_float big_float::operator*(const big_float &other) const
+{
+    big_float res(*this);
+    res *= other;
+    return res;
+}
+
+big_float &big_float::operator/=(const big_float &other) &
+{
+    if (other._mantissa == 0_bi)
+        throw std::logic_error("big_float: division by zero");
+
+    if (_mantissa == 0_bi)
+        return *this;
+
+    bool negative = (_mantissa < 0_bi) != (other._mantissa < 0_bi);
+    big_int numerator = magnitude(_mantissa), denominator = magnitude(other._mantissa);
+
+    // quotient of precision + 2 bits at least, remainder sets sticky bit
+    std::int64_t shift = std::max<std::int64_t>(0, static_cast<std::int64_t>(_precision + 2 + bit_length(denominator)) -
+                                                   static_cast<std::int64_t>(bit_length(numerator)));
+    numerator <<= static_cast<size_t>(shift);
+
+    big_int quotient = numerator / denominator;
+    bool sticky = quotient * denominator != numerator;
+
+    assign(negative, std::move(quotient), _exponent - other._exponent - shift, sticky);
+    return *this;
+}
+
+big_float big_float::operator/(const big_float &other) const
+{
+    big_float res(*this);
+    res /= other;
+    return res;
+}
+
+bool big_float::operator==(const big_float &other) const noexcept
+{
+    return _exponent == other._exponent && _mantissa == other._mantissa;
+}
+
+std::strong_ordering big_float::operator<=>(const big_float &other) const noexcept
+{
+    auto sign = [](const big_int &value) { return value == 0_bi ? 0 : value < 0_bi ? -1 : 1; };
+    int sign_this = sign(_mantissa), sign_other = sign(other._mantissa);
+
+    if (sign_this != sign_other || sign_this == 0)
+        return sign_this <=> sign_other;
+
+    std::int64_t top_this = _exponent + static_cast<std::int64_t>(bit_length(_mantissa));
+    std::int64_t top_other = other._exponent + static_cast<std::int64_t>(bit_length(other._mantissa));
+    std::strong_ordering magnitude_order = top_this <=> top_other;
+
+    if (magnitude_order == std::strong_ordering::equal)
+    {
+        // same leading bit, so shift is below precision
+        std::int64_t exponent = std::min(_exponent, other._exponent);
+        big_int a = magnitude(_mantissa) << static_cast<size_t>(_exponent - exponent);
+        big_int b = magnitude(other._mantissa) << static_cast<size_t>(other._exponent - exponent);
+
+        magnitude_order = a < b ? std::strong_ordering::less : b < a ? std::strong_ordering::greater : std::strong_ordering::equal;
+    }
+
+    return sign_this > 0 ? magnitude_order : 0 <=> magnitude_order;
+}
+
+std::ostream &operator<<(std::ostream &stream, const big_float &value)
+{
+    if (value._mantissa == 0_bi)
+        return stream << '0';
+
+    // enough digits to tell apart neighbours at precision
+    size_t digits = static_cast<size_t>(std::ceil(static_cast<double>(value._precision) * std::log10(2.0))) + 1;
+    big_int m = magnitude(value._mantissa);
+
+    double log10_value = (static_cast<double>(big_float::bit_length(m)) - 0.5 + static_cast<double>(value._exponent)) * std::log10(2.0);
+    std::int64_t decimal_exponent = static_cast<std::int64_t>(std::floor(log10_value));
+    big_int upper = power_of_ten(digits), lower = power_of_ten(digits - 1), scaled;
+
+    // scaled = round(|value| * 10^(digits - 1 - decimal_exponent)) of exactly digits digits, estimate may be off by one
+    for (;;)
+    {
+        std::int64_t k = static_cast<std::int64_t>(digits) - 1 - decimal_exponent;
+        big_int numerator = m, denominator = 1_bi;
+
+        if (value._exponent >= 0)
+            numerator <<= static_cast<size_t>(value._exponent);
+        else
+            denominator <<= static_cast<size_t>(-value._exponent);
+
+        if (k >= 0)
+            numerator *= power_of_ten(static_cast<size_t>(k));
+        else
+            denominator *= power_of_ten(static_cast<size_t>(-k));
+
+        scaled = ((numerator << 1) + denominator) / (denominator << 1);
+
+        if (scaled >= upper)
+            ++decimal_exponent;
+        else if (scaled < lower)
+            --decimal_exponent;
+        else
+            break;
+    }
+
+    std::ostringstream text;
+    text << scaled;
+    std::string significand = text.str();
+
+    significand.erase(significand.find_last_not_of('0') + 1);
+
+    if (value._mantissa < 0_bi)
+        stream << '-';
+
+    stream << significand[0];
+
+    if (significand.size() > 1)
+        stream << '.' << significand.substr(1);
+
+    return stream << 'e' << decimal_exponent;
+}
+
+std::string big_float::to_string() const
+{
+    std::ostringstream stream;
+    stream << *this;
+    return stream.str();
+}
+
+big_float big_float::sqrt() const
+{
+    if (_mantissa < 0_bi)
+        throw std::invalid_argument("big_float: square root of negative value");
+
+    big_float res(_precision, _rounding);
+
+    if (_mantissa == 0_bi)
+        return res;
+
+    // m * 2^e = (m * 2^s) * 2^(e - s) with even e - s and m * 2^s of 2 precision + 4 bits at least, so root has precision + 2
+    std::int64_t shift = std::max<std::int64_t>(0, 2 * static_cast<std::int64_t>(_precision) + 4 - static_cast<std::int64_t>(bit_length(_mantissa)));
+
+    if (((_exponent - shift) & 1) != 0)
+        ++shift;
+
+    big_int value = _mantissa << static_cast<size_t>(shift), root = value.isqrt();
+
+    res.assign(false, root, (_exponent - shift) / 2, root * root != value);
+    return res;
+}
+
+big_float big_float::exp() const
+{
+    if (_mantissa == 0_bi)
+        return big_float(1_bi, _precision, _rounding);
+
+    fraction x = to_fraction();
+    std::int64_t k = 0;
+
+    // exp(x) = exp(x - k ln 2) * 2^k and scaling by 2^k keeps rounding
+    big_float res = round_fixed([&](size_t bits) { return x.exp_fixed(bits, k); }, _precision, _rounding);
+    res._exponent += k;
+    return res;
+}
+
+big_float big_float::ln() const
+{
+    if (_mantissa <= 0_bi)
+        throw std::invalid_argument("big_float: logarithm of non-positive value");
+
+    if (_mantissa == 1_bi && _exponent == 0)
+        return big_float(_precision, _rounding);
+
+    fraction x = to_fraction();
+    return round_fixed([&](size_t bits) { return x.ln_fixed(bits); }, _precision, _rounding);
+}
+
+big_float big_float::sin() const
+{
+    if (_mantissa == 0_bi)
+        return big_float(_precision, _rounding);
+
+    fraction x = to_fraction();
+    return round_fixed([&](size_t bits) { return x.sin_fixed(bits); }, _precision, _rounding);
+}
+
+big_float big_float::cos() const
+{
+    if (_mantissa == 0_bi)
+        return big_float(1_bi, _precision, _rounding);
+
+    fraction x = to_fraction();
+    return round_fixed([&](size_t bits) { return x.cos_fixed(bits); }, _precision, _rounding);
+}
+
+big_float big_float::tg() const
+{
+    if (_mantissa == 0_bi)
+        return big_float(_precision, _rounding);
+
+    fraction x = to_fraction();
+    return round_fixed([&](size_t bits) { return x.tg_fixed(bits); }, _precision, _rounding);
+}
+
+big_float big_float::arctg() const
+{
+    if (_mantissa == 0_bi)
+        return big_float(_precision, _rounding);
+
+    fraction x = to_fraction();
+    return round_fixed([&](size_t bits) { return x.arctg_fixed(bits); }, _precision, _rounding);
+}
+
+big_float big_float::pi(size_t precision, rounding_mode rounding)
+{
+    return round_fixed([](size_t bits) { return fraction::pi_fixed(bits); }, precision, rounding);
+}
@@ -1,137 +1,1222 @@
 #include "../include/fraction.h"
+#include <stdexcept>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <cmath>
+#include <mutex>
+#include <numbers>
+
+namespace
+{
+    constexpr std::int64_t small_min = std::numeric_limits<std::int64_t>::min();
+
+    std::int64_t magnitude(std::int64_t value) noexcept
+    {
+        return value < 0 ? -value : value;
+    }
+
+    /** Overflow-checked int64 arithmetic for operands other than INT64_MIN, false when result does not fit
+     *  or equals INT64_MIN
+     */
+    bool checked_mul(std::int64_t a, std::int64_t b, std::int64_t &res) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return !__builtin_mul_overflow(a, b, &res) && res != small_min;
+#else
+        if (a != 0 && b != 0 && magnitude(a) > std::numeric_limits<std::int64_t>::max() / magnitude(b))
+            return false;
+
+        res = a * b;
+        return true;
+#endif
+    }
+
+    bool checked_add(std::int64_t a, std::int64_t b, std::int64_t &res) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return !__builtin_add_overflow(a, b, &res) && res != small_min;
+#else
+        constexpr std::int64_t max = std::numeric_limits<std::int64_t>::max();
+
+        if (b > 0 ? a > max - b : a < -max - b)
+            return false;
+
+        res = a + b;
+        return true;
+#endif
+    }
+
+    /** a / b + c / d for reduced operands by Knuth's trick: only gcd of denominators and gcd of its part
+     *  with numerator are needed, products stay as small as they can
+     */
+    bool small_add(std::int64_t a, std::int64_t b, std::int64_t c, std::int64_t d, std::int64_t &numerator, std::int64_t &denominator) noexcept
+    {
+        std::int64_t g = std::gcd(b, d);
+
+        if (g == 1)
+        {
+            std::int64_t ad, cb;
+            return checked_mul(a, d, ad) && checked_mul(c, b, cb) && checked_add(ad, cb, numerator) && checked_mul(b, d, denominator);
+        }
+
+        std::int64_t ad, cb, t;
+
+        if (!checked_mul(a, d / g, ad) || !checked_mul(c, b / g, cb) || !checked_add(ad, cb, t))
+            return false;
+
+        std::int64_t g2 = std::gcd(magnitude(t), g);
+        numerator = t / g2;
+        return checked_mul(b / g, d / g2, denominator);
+    }
+
+    /** (a / b) * (c / d) for reduced operands, cross gcds keep result reduced
+     */
+    bool small_mul(std::int64_t a, std::int64_t b, std::int64_t c, std::int64_t d, std::int64_t &numerator, std::int64_t &denominator) noexcept
+    {
+        if (a == 0 || c == 0)
+        {
+            numerator = 0;
+            denominator = 1;
+            return true;
+        }
+
+        std::int64_t g1 = std::gcd(magnitude(a), d), g2 = std::gcd(magnitude(c), b);
+        return checked_mul(a / g1, c / g2, numerator) && checked_mul(b / g2, d / g1, denominator);
+    }
+}
+
+bool fraction::fits_small(const big_int &value, std::int64_t &res) noexcept
+{
+    if (value._digits.empty())
+    {
+        res = 0;
+        return true;
+    }
+
+    if (value._digits.size() > 1 || value._digits[0] > static_cast<big_int::value_type>(std::numeric_limits<std::int64_t>::max()))
+        return false;
+
+    res = static_cast<std::int64_t>(value._digits[0]);
+
+    if (!value._sign)
+        res = -res;
+
+    return true;
+}
 
 void fraction::optimise()
 {
-    throw not_implemented("void fraction::optimise()", "your code should be here...");
+    if (_small)
+    {
+        if (_small_denominator == 0)
+            throw std::logic_error("fraction: zero denominator");
+
+        std::int64_t divisor = std::gcd(magnitude(_small_numerator), _small_denominator);
+
+        if (divisor != 1)
+        {
+            _small_numerator /= divisor;
+            _small_denominator /= divisor;
+        }
+
+        return;
+    }
+
+    if (_denominator == 0_bi)
+        throw std::logic_error("fraction: zero denominator");
+
+    if (_denominator < 0_bi)
+    {
+        _numerator = 0_bi - std::move(_numerator);
+        _denominator = 0_bi - std::move(_denominator);
+    }
+
+    if (demote())
+    {
+        optimise();
+        return;
+    }
+
+    size_t limbs = std::max(_numerator._digits.size(), _denominator._digits.size());
+
+    switch (normalization)
+    {
+        case normalization_policy::eager:
+            reduce();
+            break;
+        case normalization_policy::lazy:
+            if (limbs > normalization_threshold && limbs > 2 * _reduced_limbs)
+                reduce();
+            else
+                _reduced = false;
+            break;
+        case normalization_policy::manual:
+            _reduced = false;
+            break;
+    }
+}
+
+void fraction::reduce()
+{
+    big_int divisor = big_int::gcd(_numerator, _denominator);
+
+    if (divisor != 1_bi)
+    {
+        _numerator.divexact_assign(divisor);
+        _denominator.divexact_assign(divisor);
+    }
+
+    _reduced = true;
+    _reduced_limbs = std::max(_numerator._digits.size(), _denominator._digits.size());
+    demote();
+}
+
+bool fraction::demote()
+{
+    std::int64_t numerator, denominator;
+
+    if (!fits_small(_numerator, numerator) || !fits_small(_denominator, denominator))
+        return false;
+
+    _small = true;
+    _small_numerator = numerator;
+    _small_denominator = denominator;
+    _numerator = 0_bi;
+    _denominator = 0_bi;
+    return true;
+}
+
+bool fraction::exact_arithmetic(const big_int &numerator, const big_int &denominator) noexcept
+{
+    switch (normalization)
+    {
+        case normalization_policy::eager:
+            return true;
+        case normalization_policy::lazy:
+            return std::max(numerator._digits.size(), denominator._digits.size()) > normalization_threshold;
+        default:
+            return false;
+    }
+}
+
+void fraction::add_big(big_int numerator, big_int denominator, bool reduced)
+{
+    reduced = reduced && (_small || _reduced) && exact_arithmetic(numerator, denominator);
+    promote();
+
+    if (!reduced)
+    {
+        _numerator = _numerator * denominator + numerator * _denominator;
+        _denominator *= denominator;
+        optimise();
+        return;
+    }
+
+    // Knuth: with g = gcd(b, d), a / b + c / d = (a * d / g + c * b / g) / (b * d / g) and only g can share
+    // factors with the new numerator, so result is reduced by two gcds of operand size instead of one of product size
+    big_int divisor = big_int::gcd(_denominator, denominator);
+
+    if (divisor == 1_bi)
+    {
+        _numerator = _numerator * denominator + numerator * _denominator;
+        _denominator *= denominator;
+    } else
+    {
+        _denominator.divexact_assign(divisor);
+        denominator.divexact_assign(divisor);
+        _numerator = _numerator * denominator + numerator * _denominator;
+
+        big_int common = big_int::gcd(_numerator, divisor);
+
+        if (common != 1_bi)
+        {
+            _numerator.divexact_assign(common);
+            divisor.divexact_assign(common);
+        }
+
+        _denominator *= denominator * divisor;
+    }
+
+    if (_numerator == 0_bi)
+        _denominator = 1_bi;
+
+    _reduced = true;
+    _reduced_limbs = std::max(_numerator._digits.size(), _denominator._digits.size());
+    demote();
+}
+
+void fraction::multiply_big(big_int numerator, big_int denominator, bool reduced)
+{
+    reduced = reduced && (_small || _reduced) && exact_arithmetic(numerator, denominator);
+    promote();
+
+    if (!reduced)
+    {
+        _numerator *= numerator;
+        _denominator *= denominator;
+        optimise();
+        return;
+    }
+
+    // cross gcds leave product of reduced fractions reduced
+    big_int first = big_int::gcd(_numerator, denominator), second = big_int::gcd(numerator, _denominator);
+
+    if (first != 1_bi)
+    {
+        _numerator.divexact_assign(first);
+        denominator.divexact_assign(first);
+    }
+
+    if (second != 1_bi)
+    {
+        numerator.divexact_assign(second);
+        _denominator.divexact_assign(second);
+    }
+
+    _numerator *= numerator;
+    _denominator *= denominator;
+
+    if (_numerator == 0_bi)
+        _denominator = 1_bi;
+
+    _reduced = true;
+    _reduced_limbs = std::max(_numerator._digits.size(), _denominator._digits.size());
+    demote();
+}
+
+fraction &fraction::normalize() &
+{
+    if (!_small && !_reduced)
+        reduce();
+
+    return *this;
+}
+
+void fraction::promote()
+{
+    if (!_small)
+        return;
+
+    _numerator = big_int(_small_numerator);
+    _denominator = big_int(_small_denominator);
+    _small = false;
+    _reduced = true;
+    _reduced_limbs = 1;
 }
 
-template<std::convertible_to<big_int> f, std::convertible_to<big_int> s>
-fraction::fraction(f &&numerator, s &&denominator)
+big_int fraction::big_numerator() const
 {
-    throw not_implemented("template<std::convertible_to<big_int> f, std::convertible_to<big_int> s> fraction::fraction(f &&, s &&)", "your code should be here...");
+    return _small ? big_int(_small_numerator) : _numerator;
 }
 
-fraction::fraction(pp_allocator<big_int::value_type>)
+big_int fraction::big_denominator() const
 {
-    throw not_implemented("fraction::fraction(pp_allocator<big_int::value_type>)", "your code should be here...");
+    return _small ? big_int(_small_denominator) : _denominator;
+}
+
+fraction::fraction(pp_allocator<big_int::value_type> allocator) : _small(true), _small_numerator(0), _small_denominator(1),
+                                                                  _numerator(allocator), _denominator(allocator), _reduced(true), _reduced_limbs(0)
+{
+
 }
 
 fraction &fraction::operator+=(fraction const &other) &
 {
-    throw not_implemented("fraction &fraction::operator+=(fraction const &) &", "your code should be here...");
+    std::int64_t numerator, denominator;
+
+    if (_small && other._small && small_add(_small_numerator, _small_denominator, other._small_numerator, other._small_denominator, numerator, denominator))
+    {
+        _small_numerator = numerator;
+        _small_denominator = denominator;
+        return *this;
+    }
+
+    add_big(other.big_numerator(), other.big_denominator(), other._small || other._reduced);
+    return *this;
 }
 
 fraction fraction::operator+(fraction const &other) const
 {
-    throw not_implemented("fraction fraction::operator+(fraction const &) const", "your code should be here...");
+    fraction res(*this);
+    res += other;
+    return res;
 }
 
 fraction &fraction::operator-=(fraction const &other) &
 {
-    throw not_implemented("fraction &fraction::operator-=(fraction const &) &", "your code should be here...");
+    std::int64_t numerator, denominator;
+
+    if (_small && other._small && small_add(_small_numerator, _small_denominator, -other._small_numerator, other._small_denominator, numerator, denominator))
+    {
+        _small_numerator = numerator;
+        _small_denominator = denominator;
+        return *this;
+    }
+
+    add_big(0_bi - other.big_numerator(), other.big_denominator(), other._small || other._reduced);
+    return *this;
 }
 
 fraction fraction::operator-(fraction const &other) const
 {
-    throw not_implemented("fraction fraction::operator-(fraction const &) const", "your code should be here...");
+    fraction res(*this);
+    res -= other;
+    return res;
 }
 
 fraction &fraction::operator*=(fraction const &other) &
 {
-    throw not_implemented("fraction &fraction::operator*=(fraction const &) &", "your code should be here...");
+    std::int64_t numerator, denominator;
+
+    if (_small && other._small && small_mul(_small_numerator, _small_denominator, other._small_numerator, other._small_denominator, numerator, denominator))
+    {
+        _small_numerator = numerator;
+        _small_denominator = denominator;
+        return *this;
+    }
+
+    multiply_big(other.big_numerator(), other.big_denominator(), other._small || other._reduced);
+    return *this;
 }
 
 fraction fraction::operator*(fraction const &other) const
 {
-    throw not_implemented("fraction fraction::operator*(fraction const &) const", "your code should be here...");
+    fraction res(*this);
+    res *= other;
+    return res;
 }
 
 fraction &fraction::operator/=(fraction const &other) &
 {
-    throw not_implemented("fraction &fraction::operator/=(fraction const &) &", "your code should be here...");
+    if (other._small ? other._small_numerator == 0 : other._numerator == 0_bi)
+        throw std::logic_error("fraction: division by zero");
+
+    std::int64_t numerator, denominator;
+
+    // reciprocal keeps sign in numerator, both parts are below INT64_MAX in magnitude
+    if (_small && other._small && small_mul(_small_numerator, _small_denominator,
+                                            other._small_numerator < 0 ? -other._small_denominator : other._small_denominator,
+                                            magnitude(other._small_numerator), numerator, denominator))
+    {
+        _small_numerator = numerator;
+        _small_denominator = denominator;
+        return *this;
+    }
+
+    big_int other_numerator = other.big_numerator(), other_denominator = other.big_denominator();
+
+    if (other_numerator < 0_bi)
+    {
+        other_numerator = 0_bi - std::move(other_numerator);
+        other_denominator = 0_bi - std::move(other_denominator);
+    }
+
+    multiply_big(std::move(other_denominator), std::move(other_numerator), other._small || other._reduced);
+    return *this;
 }
 
 fraction fraction::operator/(fraction const &other) const
 {
-    throw not_implemented("fraction fraction::operator/(fraction const &) const", "your code should be here...");
+    fraction res(*this);
+    res /= other;
+    return res;
 }
 
 bool fraction::operator==(fraction const &other) const noexcept
 {
-    throw not_implemented("bool fraction::operator==(fraction const &) const noexcept", "your code should be here...");
+    if (_small && other._small)
+        return _small_numerator == other._small_numerator && _small_denominator == other._small_denominator;
+
+    // reduced value that fits int64 is always small, so reduced forms are equal only if representations are
+    if ((_small || _reduced) && (other._small || other._reduced))
+        return _small == other._small && _numerator == other._numerator && _denominator == other._denominator;
+
+    return big_numerator() * other.big_denominator() == other.big_numerator() * big_denominator();
 }
 
 std::partial_ordering fraction::operator<=>(const fraction& other) const noexcept
 {
-    throw not_implemented("std::partial_ordering fraction::operator<=>(const fraction& ) const noexcept", "your code should be here...");
+#if defined(MP_OS_BIG_INT_HAS_INT128)
+    if (_small && other._small)
+        return static_cast<__int128>(_small_numerator) * other._small_denominator <=> static_cast<__int128>(other._small_numerator) * _small_denominator;
+#endif
+
+    // denominators are positive
+    big_int lhs = big_numerator() * other.big_denominator(), rhs = other.big_numerator() * big_denominator();
+
+    if (lhs < rhs)
+        return std::partial_ordering::less;
+
+    return lhs == rhs ? std::partial_ordering::equivalent : std::partial_ordering::greater;
 }
 
 std::ostream &operator<<(std::ostream &stream, fraction const &obj)
 {
-    throw not_implemented("std::ostream &operator<<(std::ostream &, fraction const &)", "your code should be here...");
+    if (obj._small)
+        return stream << obj._small_numerator << '/' << obj._small_denominator;
+
+    if (!obj._reduced)
+    {
+        fraction reduced(obj);
+        return stream << reduced.normalize();
+    }
+
+    return stream << obj._numerator << '/' << obj._denominator;
 }
 
 std::istream &operator>>(std::istream &stream, fraction &obj)
 {
-    throw not_implemented("std::istream &operator>>(std::istream &, fraction &)", "your code should be here...");
+    big_int numerator, denominator(1);
+
+    if (!(stream >> numerator))
+        return stream;
+
+    if (stream.peek() == '/')
+    {
+        stream.get();
+
+        if (!(stream >> denominator))
+            return stream;
+    }
+
+    if (denominator == 0_bi)
+    {
+        stream.setstate(std::ios_base::failbit);
+        return stream;
+    }
+
+    obj = fraction(std::move(numerator), std::move(denominator));
+    return stream;
 }
 
 std::string fraction::to_string() const
 {
-    throw not_implemented("std::string fraction::to_string() const", "your code should be here...");
+    std::ostringstream stream;
+    stream << *this;
+    return stream.str();
+}
+
+namespace
+{
+    /** Partial sum of series with k-th term p(0) ... p(k) / (b(k) * q(0) ... q(k) * 2^(s(0) + ... + s(k))) over
+     *  a range of k: p, q, b, shift are products and sum of s over the range and t / (b * q * 2^shift) is the sum
+     */
+    struct split_sum
+    {
+        big_int p;
+        big_int q;
+        big_int b;
+        big_int t;
+        size_t shift;
+    };
+
+    /** Binary splitting (Haible, Papanikolaou): halves are summed recursively and joined by
+     *  t = b_r * q_r * t_l * 2^shift_r + b_l * p_l * t_r, so cost is dominated by few balanced multiplications of
+     *  large numbers. Powers of two in denominators are kept as shifts and never multiplied.
+     *  term(k, p, q, b, s) sets factors of k-th term, b is ignored when unit_b is set
+     */
+    template<class Term>
+    split_sum binary_split(size_t begin, size_t end, bool unit_b, const Term &term)
+    {
+        if (end - begin == 1)
+        {
+            split_sum res{0_bi, 0_bi, 1_bi, 0_bi, 0};
+            term(begin, res.p, res.q, res.b, res.shift);
+            res.t = res.p;
+            return res;
+        }
+
+        size_t middle = begin + (end - begin) / 2;
+        split_sum left = binary_split(begin, middle, unit_b, term), right = binary_split(middle, end, unit_b, term);
+
+        if (unit_b)
+        {
+            left.t = ((right.q * left.t) << right.shift) + left.p * right.t;
+        } else
+        {
+            left.t = ((right.b * right.q * left.t) << right.shift) + left.b * left.p * right.t;
+            left.b *= right.b;
+        }
+
+        left.q *= right.q;
+        left.p *= right.p;
+        left.shift += right.shift;
+
+        return left;
+    }
+
+    /** Sum of first terms of series times 2^bits, truncated
+     */
+    template<class Term>
+    big_int series_fixed(size_t terms, size_t bits, bool unit_b, const Term &term)
+    {
+        if (terms == 0)
+            return 0_bi;
+
+        split_sum sum = binary_split(0, terms, unit_b, term);
+        big_int denominator = unit_b ? std::move(sum.q) : sum.b * sum.q;
+
+        return sum.shift <= bits ? (sum.t << (bits - sum.shift)) / denominator :
+                                   sum.t / (denominator << (sum.shift - bits));
+    }
+
+    /** Count n of terms to sum so that |t_n| < 2^-bits and terms decrease from n on. first is log2 |t_0|,
+     *  ratio(k) is log2 |t_k / t_(k-1)| and decreases with k
+     */
+    template<class Ratio>
+    size_t terms_needed(double first, double bits, const Ratio &ratio)
+    {
+        double log_term = first;
+
+        for (size_t k = 0;; ++k)
+        {
+            double next = ratio(k + 1);
+
+            if (log_term < -bits && next <= 0)
+                return k;
+
+            log_term += next;
+        }
+    }
+
+    /** arctg(u / v) or artanh(u / v) times 2^bits for |u| < v
+     */
+    big_int arctg_series_fixed(const big_int &u, const big_int &v, size_t bits, bool hyperbolic, double log2_z)
+    {
+        if (u == 0_bi)
+            return 0_bi;
+
+        // artanh has no alternating signs, its tail is below t_n / (1 - z^2)
+        double tail = hyperbolic ? -std::log2(1 - std::exp2(2 * log2_z)) : 0;
+        size_t terms = terms_needed(log2_z, bits + 2 + tail, [&](size_t k)
+        {
+            return 2 * log2_z + std::log2((2.0 * k - 1) / (2.0 * k + 1));
+        });
+
+        big_int u2 = u * u, v2 = v * v;
+
+        if (!hyperbolic)
+            u2 = 0_bi - u2;
+
+        return series_fixed(terms, bits, false, [&](size_t k, big_int &p, big_int &q, big_int &b, size_t &)
+        {
+            p = k == 0 ? u : u2;
+            q = k == 0 ? v : v2;
+            b = big_int(2 * k + 1);
+        });
+    }
+
+    /** sin(u / (v * 2^shift)) times 2^bits with log2_x = log2 |u / (v * 2^shift)|, number of terms grows with
+     *  the argument
+     */
+    big_int sin_series(const big_int &u, const big_int &v, size_t shift, size_t bits, double log2_x)
+    {
+        size_t terms = terms_needed(log2_x, bits + 2, [&](size_t k)
+        {
+            return 2 * log2_x - std::log2(2.0 * k * (2.0 * k + 1));
+        });
+
+        big_int u2 = 0_bi - u * u, v2 = v * v;
+
+        return series_fixed(terms, bits, true, [&](size_t k, big_int &p, big_int &q, big_int &, size_t &s)
+        {
+            p = k == 0 ? u : u2;
+            q = k == 0 ? v : v2 * big_int(2 * k) * big_int(2 * k + 1);
+            s = k == 0 ? shift : 2 * shift;
+        });
+    }
+
+    /** cos(u / (v * 2^shift)) times 2^bits, as sin_series
+     */
+    big_int cos_series(const big_int &u, const big_int &v, size_t shift, size_t bits, double log2_x)
+    {
+        size_t terms = terms_needed(0, bits + 2, [&](size_t k)
+        {
+            return 2 * log2_x - std::log2((2.0 * k - 1) * (2.0 * k));
+        });
+
+        big_int u2 = 0_bi - u * u, v2 = v * v;
+
+        return series_fixed(terms, bits, true, [&](size_t k, big_int &p, big_int &q, big_int &, size_t &s)
+        {
+            p = k == 0 ? 1_bi : u2;
+            q = k == 0 ? 1_bi : v2 * big_int(2 * k - 1) * big_int(2 * k);
+            s = k == 0 ? 0 : 2 * shift;
+        });
+    }
+
+    /** exp(u / (v * 2^shift)) times 2^bits, as sin_series
+     */
+    big_int exp_series(const big_int &u, const big_int &v, size_t shift, size_t bits, double log2_x)
+    {
+        // positive terms past k > 2x shrink at least twice each, tail is below last term
+        size_t terms = terms_needed(0, bits + 3, [&](size_t k)
+        {
+            return log2_x - std::log2(static_cast<double>(k));
+        });
+
+        return series_fixed(terms, bits, true, [&](size_t k, big_int &p, big_int &q, big_int &, size_t &s)
+        {
+            p = k == 0 ? 1_bi : u;
+            q = k == 0 ? 1_bi : v * big_int(k);
+            s = k == 0 ? 0 : shift;
+        });
+    }
+
+    /** Arguments whose numerator and denominator fit in this many bits go to series as they are, binary splitting
+     *  keeps their terms short. Longer ones are rounded to fixed point and reduced first
+     */
+    constexpr double direct_series_bits = 64;
+
+    /** Short arguments up to 2^direct_series_log2 go to series as they are, ones up to 2^halving_log2 are halved
+     *  below 1 instead of reduced modulo pi/2
+     */
+    constexpr double direct_series_log2 = 4;
+
+    constexpr double halving_log2 = 32;
+
+    /** Length of first chunk of long arguments, next ones double it
+     */
+    constexpr size_t first_chunk_bits = 16;
+
+    /** Constant kept at the longest precision requested so far, shorter requests truncate it
+     */
+    struct constant_cache
+    {
+        std::mutex mutex;
+        big_int value;
+        size_t bits = 0;
+    };
+
+    template<class Compute>
+    big_int cached_constant(constant_cache &cache, size_t bits, const Compute &compute)
+    {
+        std::lock_guard lock(cache.mutex);
+
+        if (cache.bits < bits)
+        {
+            // growing by half at least, so slowly rising precision recomputes rarely
+            cache.bits = std::max(bits, cache.bits + cache.bits / 2);
+            cache.value = compute(cache.bits);
+        }
+
+        return cache.value >> (cache.bits - bits);
+    }
+
+    big_int magnitude(const big_int &value)
+    {
+        return value < 0_bi ? 0_bi - value : value;
+    }
+
+    /** num(bits) / den(bits) times 2^bits for fixed point evaluations off by less than 2 with |num| <= 1.
+     *  Denominator is first probed at growing precision until its size is known, then both are evaluated
+     *  with twice as many extra bits as its leading zeros, so quotient is off by less than 2 too
+     */
+    template<class Numerator, class Denominator>
+    big_int fixed_quotient(size_t bits, const Numerator &numerator, const Denominator &denominator)
+    {
+        size_t probe = 32;
+        big_int value;
+
+        for (;; probe *= 2)
+        {
+            value = magnitude(denominator(probe));
+
+            if (value > 4_bi)
+                break;
+        }
+
+        value -= 2_bi;
+
+        // leading zeros of lower bound of |denominator| below 1
+        size_t zeros = 0;
+
+        while ((value << zeros) < (1_bi << probe))
+            ++zeros;
+
+        size_t extended = bits + 2 * zeros + 4;
+        return (numerator(extended) << bits) / denominator(extended);
+    }
+}
+
+double fraction::log2_magnitude(const big_int &value) noexcept
+{
+    const auto &digits = value._digits;
+
+    if (digits.empty())
+        return -std::numeric_limits<double>::infinity();
+
+    size_t n = digits.size();
+    double top = static_cast<double>(digits[n - 1]) + (n > 1 ? static_cast<double>(digits[n - 2]) * 0x1p-64 : 0.0);
+
+    return std::log2(top) + 64.0 * static_cast<double>(n - 1);
+}
+
+size_t fraction::precision_bits(fraction const &epsilon)
+{
+    if (epsilon <= fraction())
+        throw std::invalid_argument("fraction: epsilon must be positive");
+
+    // one more bit covers rounding of logarithms
+    double bits = log2_magnitude(epsilon.big_denominator()) - log2_magnitude(epsilon.big_numerator());
+    return bits > 0 ? static_cast<size_t>(std::ceil(bits)) + 1 : 1;
+}
+
+big_int fraction::sin_fixed(size_t bits) const
+{
+    return trig_fixed(bits, false);
+}
+
+big_int fraction::cos_fixed(size_t bits) const
+{
+    return trig_fixed(bits, true);
+}
+
+big_int fraction::trig_fixed(size_t bits, bool cosine) const
+{
+    big_int u = big_numerator(), v = big_denominator();
+
+    if (u == 0_bi)
+        return cosine ? 1_bi << bits : 0_bi;
+
+    double log2_x = log2_magnitude(u) - log2_magnitude(v);
+    bool short_argument = log2_magnitude(u) <= direct_series_bits && log2_magnitude(v) <= direct_series_bits;
+
+    if (short_argument && log2_x <= direct_series_log2)
+        return cosine ? cos_series(u, v, 0, bits, log2_x) : sin_series(u, v, 0, bits, log2_x);
+
+    bool negative = u < 0_bi;
+    u = magnitude(u);
+
+    std::int64_t quadrant = 0;
+    size_t t;
+    big_int s, c;
+
+    if (short_argument && log2_x <= halving_log2)
+    {
+        // x / 2^h below 1 stays short, h doublings restore x and lose up to 2 bits each
+        size_t h = static_cast<size_t>(std::floor(log2_x)) + 1;
+        t = bits + 2 * h + 4;
+
+        s = sin_series(u, v, h, t, log2_x - static_cast<double>(h));
+        c = cos_series(u, v, h, t, log2_x - static_cast<double>(h));
+
+        for (size_t i = 0; i < h; ++i)
+        {
+            big_int doubled_s = (s * c) >> (t - 1);
+            c = (c * c - s * s) >> t;
+            s = std::move(doubled_s);
+        }
+    } else if (log2_x < -1)
+    {
+        // below 1/2 n is 0 and pi is not needed
+        t = bits + 8;
+        sin_cos_fixed((u << t) / v, t, t, s, c);
+    } else
+    {
+        // |x| = n pi/2 + r with |r| <= pi/4 at scale 2^w, n times error of pi/2 stays below 2^(w - bits - 3)
+        size_t magnitude_bits = log2_x > 0 ? static_cast<size_t>(std::ceil(log2_x)) : 0;
+        size_t w = bits + magnitude_bits + 6;
+        big_int half_pi = pi_fixed(w - 1), x = (u << w) / v;
+        big_int n = ((x << 1) + half_pi) / (half_pi << 1);
+
+        fits_small(n & 3_bi, quadrant);
+
+        t = bits + 8;
+        sin_cos_fixed(x - n * half_pi, w, t, s, c);
+    }
+
+    big_int res;
+
+    switch (quadrant)
+    {
+        case 0:
+            res = cosine ? std::move(c) : std::move(s);
+            break;
+        case 1:
+            res = cosine ? 0_bi - s : std::move(c);
+            break;
+        case 2:
+            res = cosine ? 0_bi - c : 0_bi - s;
+            break;
+        default:
+            res = cosine ? std::move(s) : 0_bi - c;
+            break;
+    }
+
+    res >>= t - bits;
+    return negative && !cosine ? 0_bi - res : res;
+}
+
+void fraction::sin_cos_fixed(big_int angle, size_t scale, size_t bits, big_int &sin, big_int &cos)
+{
+    bool negative = angle < 0_bi;
+    angle = magnitude(angle);
+
+    sin = 0_bi;
+    cos = 1_bi << bits;
+
+    // chunk ending at bit p of fraction is below 2^(-p / 2) and has p / 2 bits, its series need about bits / p terms.
+    // Every chunk costs up to 6 units of last place, guard bits of caller cover 2 + log2(bits) chunks
+    for (size_t p = first_chunk_bits; angle != 0_bi; p *= 2)
+    {
+        big_int chunk = p >= scale ? std::move(angle) : angle >> (scale - p);
+        size_t chunk_scale = std::min(p, scale);
+
+        if (p < scale)
+            angle -= chunk << (scale - p);
+        else
+            angle = 0_bi;
+
+        if (chunk == 0_bi)
+            continue;
+
+        double log2_chunk = log2_magnitude(chunk) - static_cast<double>(chunk_scale);
+        big_int chunk_sin = sin_series(chunk, 1_bi, chunk_scale, bits, log2_chunk), chunk_cos = cos_series(chunk, 1_bi, chunk_scale, bits, log2_chunk);
+
+        big_int next_sin = (sin * chunk_cos + cos * chunk_sin) >> bits;
+        cos = (cos * chunk_cos - sin * chunk_sin) >> bits;
+        sin = std::move(next_sin);
+    }
+
+    if (negative)
+        sin = 0_bi - sin;
+}
+
+big_int fraction::pi_fixed(size_t bits)
+{
+    static constant_cache cache;
+
+    return cached_constant(cache, bits, [](size_t b)
+    {
+        // Machin: pi = 16 arctg(1 / 5) - 4 arctg(1 / 239)
+        size_t extended = b + 6;
+        big_int pi = (arctg_series_fixed(1_bi, 5_bi, extended, false, -std::log2(5.0)) << 4) -
+                     (arctg_series_fixed(1_bi, 239_bi, extended, false, -std::log2(239.0)) << 2);
+
+        return pi >> 6;
+    });
+}
+
+big_int fraction::ln2_fixed(size_t bits)
+{
+    static constant_cache cache;
+
+    return cached_constant(cache, bits, [](size_t b)
+    {
+        // ln 2 = 2 artanh(1 / 3)
+        return arctg_series_fixed(1_bi, 3_bi, b + 1, true, -std::log2(3.0));
+    });
+}
+
+big_int fraction::arctg_fixed(size_t bits) const
+{
+    big_int u = big_numerator(), v = big_denominator();
+    bool negative = u < 0_bi;
+    u = magnitude(u);
+
+    // series converge for |x| <= 1/3: arctg(x) = pi/2 - arctg(1 / x) above 1 and pi/4 + arctg((x - 1) / (x + 1)) above 1/2
+    size_t extended = bits + 4;
+    big_int res;
+
+    if (u > v)
+        res = (pi_fixed(extended) >> 1) - arctg_series_fixed(v, u, extended, false, log2_magnitude(v) - log2_magnitude(u));
+    else if (u << 1 > v)
+    {
+        big_int w = u - v, s = u + v;
+        res = (pi_fixed(extended) >> 2) + arctg_series_fixed(w, s, extended, false, log2_magnitude(w) - log2_magnitude(s));
+    } else
+        res = arctg_series_fixed(u, v, extended, false, log2_magnitude(u) - log2_magnitude(v));
+
+    res >>= 4;
+    return negative ? 0_bi - res : res;
+}
+
+big_int fraction::ln_fixed(size_t bits) const
+{
+    big_int u = big_numerator(), v = big_denominator();
+
+    if (u <= 0_bi)
+        throw std::invalid_argument("fraction: logarithm of non-positive value");
+
+    // x = 2^k * y with y in [1/sqrt(2), sqrt(2)] keeps series below, k ln 2 is added back
+    double log2_x = log2_magnitude(u) - log2_magnitude(v);
+    long long k = std::llround(log2_x);
+
+    if (k > 0)
+        v <<= static_cast<size_t>(k);
+    else if (k < 0)
+        u <<= static_cast<size_t>(-k);
+
+    size_t extended = bits + (k == 0 ? 0 : static_cast<size_t>(std::ceil(std::log2(std::abs(static_cast<double>(k))))) + 2);
+    big_int res;
+
+    if (log2_magnitude(u) <= direct_series_bits && log2_magnitude(v) <= direct_series_bits)
+    {
+        // ln(y) = 2 artanh((y - 1) / (y + 1)), series is evaluated at one more bit
+        big_int w = u - v, s = u + v;
+        res = arctg_series_fixed(w, s, extended + 1, true, log2_magnitude(w) - log2_magnitude(s));
+    } else
+    {
+        size_t t = extended + 8;
+        res = ln_fixed((u << t) / v, t, t) >> 8;
+    }
+
+    if (k != 0)
+        res += ln2_fixed(extended) * big_int(k);
+
+    return res >> (extended - bits);
+}
+
+big_int fraction::ln_fixed(big_int value, size_t scale, size_t bits)
+{
+    big_int res = 0_bi;
+
+    // value / chunk is 1 + O(2^-p) at scale 2^bits, next chunk of p bits has series of about bits / p terms.
+    // Every chunk costs up to 3 units of last place, guard bits of caller cover 2 + log2(bits) chunks
+    size_t p = first_chunk_bits;
+
+    for (; p < bits; p *= 2)
+    {
+        big_int chunk = p >= scale ? value << (p - scale) : value >> (scale - p);
+        big_int w = chunk - (1_bi << p), s = chunk + (1_bi << p);
+
+        res += arctg_series_fixed(w, s, bits + 1, true, log2_magnitude(w) - log2_magnitude(s));
+        value = (value << p) / chunk;
+    }
+
+    // rest is 1 + d with d^2 below 2^-bits: ln(1 + d) = d - d^2 / 2 + O(d^3)
+    big_int d = value - (1_bi << scale);
+
+    if (scale != bits)
+        d = scale > bits ? d >> (scale - bits) : d << (bits - scale);
+
+    return res + d - ((d * d) >> (bits + 1));
+}
+
+big_int fraction::tg_fixed(size_t bits) const
+{
+    return fixed_quotient(bits, [this](size_t b) { return sin_fixed(b); }, [this](size_t b) { return cos_fixed(b); });
+}
+
+big_int fraction::exp_fixed(size_t bits, std::int64_t &k) const
+{
+    big_int u = big_numerator(), v = big_denominator();
+    k = 0;
+
+    if (u == 0_bi)
+        return 1_bi << bits;
+
+    double log2_x = log2_magnitude(u) - log2_magnitude(v);
+
+    if (log2_x > 60)
+        throw std::out_of_range("fraction: exponent is too large");
+
+    double x = u < 0_bi ? -std::exp2(log2_x) : std::exp2(log2_x);
+    k = std::llround(x / std::numbers::ln2);
+
+    if (k == 0 && log2_magnitude(u) <= direct_series_bits && log2_magnitude(v) <= direct_series_bits)
+        return exp_series(u, v, 0, bits, log2_x);
+
+    // r = x - k ln 2 at scale 2^w, k times error of ln 2 stays below 2^(w - bits - 2)
+    size_t k_bits = k == 0 ? 0 : static_cast<size_t>(std::ceil(std::log2(std::abs(static_cast<double>(k))))) + 1;
+    size_t w = bits + k_bits + 4;
+    big_int r = (u << w) / v - ln2_fixed(w) * big_int(k);
+
+    return exp_fixed(std::move(r), w, bits + 8) >> 8;
+}
+
+big_int fraction::exp_fixed(big_int value, size_t scale, size_t bits)
+{
+    big_int res = 1_bi << bits;
+
+    // as in sin_cos_fixed, every chunk costs up to 4 units of last place
+    for (size_t p = first_chunk_bits; value != 0_bi; p *= 2)
+    {
+        big_int chunk = p >= scale ? std::move(value) : value >> (scale - p);
+        size_t chunk_scale = std::min(p, scale);
+
+        if (p < scale)
+            value -= chunk << (scale - p);
+        else
+            value = 0_bi;
+
+        if (chunk == 0_bi)
+            continue;
+
+        double log2_chunk = log2_magnitude(chunk) - static_cast<double>(chunk_scale);
+        res = (res * exp_series(chunk, 1_bi, chunk_scale, bits, log2_chunk)) >> bits;
+    }
+
+    return res;
 }
 
 fraction fraction::sin(fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::sin(fraction const &) const", "your code should be here...");
+    size_t bits = precision_bits(epsilon) + 2;
+    return fraction(sin_fixed(bits), 1_bi << bits);
 }
 
 fraction fraction::cos(fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::cos(fraction const &) const", "your code should be here...");
+    size_t bits = precision_bits(epsilon) + 2;
+    return fraction(cos_fixed(bits), 1_bi << bits);
 }
 
 fraction fraction::tg(fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::tg(fraction const &) const", "your code should be here...");
+    size_t bits = precision_bits(epsilon) + 2;
+    return fraction(tg_fixed(bits), 1_bi << bits);
 }
 
 fraction fraction::ctg(fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::ctg(fraction const &) const", "your code should be here...");
+    if (*this == fraction())
+        throw std::logic_error("fraction: cotangent of zero");
+
+    size_t bits = precision_bits(epsilon) + 2;
+    return fraction(fixed_quotient(bits, [this](size_t b) { return cos_fixed(b); }, [this](size_t b) { return sin_fixed(b); }), 1_bi << bits);
 }
 
 fraction fraction::sec(fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::sec(fraction const &) const", "your code should be here...");
+    size_t bits = precision_bits(epsilon) + 2;
+    return fraction(fixed_quotient(bits, [](size_t b) { return 1_bi << b; }, [this](size_t b) { return cos_fixed(b); }), 1_bi << bits);
 }
 
 fraction fraction::cosec(fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::cosec(fraction const &) const", "your code should be here...");
+    if (*this == fraction())
+        throw std::logic_error("fraction: cosecant of zero");
+
+    size_t bits = precision_bits(epsilon) + 2;
+    return fraction(fixed_quotient(bits, [](size_t b) { return 1_bi << b; }, [this](size_t b) { return sin_fixed(b); }), 1_bi << bits);
+}
+
+fraction fraction::arcsin(fraction const &epsilon) const
+{
+    big_int u = big_numerator(), v = big_denominator();
+
+    if (magnitude(u) > v)
+        throw std::invalid_argument("fraction: arcsine argument is out of [-1, 1]");
+
+    size_t bits = precision_bits(epsilon) + 2;
+
+    // arcsin(x) = 2 arctg(x / (1 + sqrt(1 - x^2))), root is truncated to 2^-(bits + 3) and moves result by less
+    size_t extended = bits + 3;
+    big_int root = (((v * v - u * u) << (2 * extended)) / (v * v)).isqrt();
+    fraction half(u << extended, v * ((1_bi << extended) + root));
+
+    return fraction(half.arctg_fixed(bits + 1), 1_bi << bits);
+}
+
+fraction fraction::arccos(fraction const &epsilon) const
+{
+    size_t bits = precision_bits(epsilon) + 3;
+    return fraction(pi_fixed(bits) >> 1, 1_bi << bits) - arcsin(fraction(1_bi, 1_bi << bits));
+}
+
+fraction fraction::arctg(fraction const &epsilon) const
+{
+    size_t bits = precision_bits(epsilon) + 2;
+    return fraction(arctg_fixed(bits), 1_bi << bits);
+}
+
+fraction fraction::arcctg(fraction const &epsilon) const
+{
+    size_t bits = precision_bits(epsilon) + 3;
+    return fraction((pi_fixed(bits) >> 1) - arctg_fixed(bits), 1_bi << bits);
+}
+
+fraction fraction::arcsec(fraction const &epsilon) const
+{
+    if (magnitude(big_numerator()) < big_denominator())
+        throw std::invalid_argument("fraction: arcsecant argument is inside (-1, 1)");
+
+    return (fraction(1_bi, 1_bi) / *this).arccos(epsilon);
+}
+
+fraction fraction::arccosec(fraction const &epsilon) const
+{
+    if (magnitude(big_numerator()) < big_denominator())
+        throw std::invalid_argument("fraction: arccosecant argument is inside (-1, 1)");
+
+    return (fraction(1_bi, 1_bi) / *this).arcsin(epsilon);
 }
 
 fraction fraction::pow(size_t degree) const
 {
-    throw not_implemented("fraction fraction::pow(size_t) const", "your code should be here...");
+    // powers of reduced fraction stay reduced
+    fraction res(1_bi, 1_bi), square(*this);
+
+    for (size_t exponent = degree; exponent != 0; exponent >>= 1)
+    {
+        if (exponent & 1)
+            res *= square;
+        if (exponent > 1)
+            square *= square;
+    }
+
+    return res;
 }
 
 fraction fraction::root(size_t degree, fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::root(size_t , fraction const &) const", "your code should be here...");
+    if (epsilon <= fraction())
+        throw std::invalid_argument("fraction: epsilon must be positive");
+
+    // checked before scaling, truncated radicand of small negative value would be zero
+    if (degree == 0)
+        throw std::invalid_argument("fraction: root of degree zero");
+
+    if (degree % 2 == 0 && big_numerator() < 0_bi)
+        throw std::invalid_argument("fraction: even root of negative value");
+
+    // root(a / b) = root(a * scale^degree / b) / scale truncated by less than 1 / scale <= epsilon,
+    // inner quotient may be truncated too since integer roots change only at integers
+    big_int epsilon_numerator = epsilon.big_numerator();
+    big_int scale = (epsilon.big_denominator() + epsilon_numerator - 1_bi) / epsilon_numerator;
+    big_int power = 1_bi, square = scale;
+
+    for (size_t exponent = degree; exponent != 0; exponent >>= 1)
+    {
+        if (exponent & 1)
+            power *= square;
+        if (exponent > 1)
+            square *= square;
+    }
+
+    big_int radicand = big_numerator() * power / big_denominator();
+    return fraction(radicand.iroot(degree), std::move(scale));
 }
 
 fraction fraction::log2(fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::log2(fraction const &) const", "your code should be here...");
+    size_t bits = precision_bits(epsilon) + 2;
+
+    // quotient error grows with |ln x| < |log2 x| + 1
+    double magnitude_log = std::abs(log2_magnitude(big_numerator()) - log2_magnitude(big_denominator())) + 2;
+    size_t extended = bits + static_cast<size_t>(std::ceil(std::log2(magnitude_log))) + 6;
+
+    return fraction((ln_fixed(extended) << bits) / ln2_fixed(extended), 1_bi << bits);
 }
 
 fraction fraction::ln(fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::ln(fraction const &) const", "your code should be here...");
+    size_t bits = precision_bits(epsilon) + 2;
+    return fraction(ln_fixed(bits), 1_bi << bits);
 }
 
 fraction fraction::lg(fraction const &epsilon) const
 {
-    throw not_implemented("fraction fraction::lg(fraction const &) const", "your code should be here...");
-}
\ No newline at end of file
+    size_t bits = precision_bits(epsilon) + 2;
+
+    double magnitude_log = std::abs(log2_magnitude(big_numerator()) - log2_magnitude(big_denominator())) + 2;
+    size_t extended = bits + static_cast<size_t>(std::ceil(std::log2(magnitude_log))) + 6;
+
+    // ln 10 = 3 ln 2 + 2 artanh(1 / 9)
+    big_int ln10 = ln2_fixed(extended + 2) * 3_bi + arctg_series_fixed(1_bi, 9_bi, extended + 3, true, -std::log2(9.0));
+
+    return fraction((ln_fixed(extended) << bits) / (ln10 >> 2), 1_bi << bits);
+}
@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <sstream>
+
+#include <big_float.h>
+#include <client_logger.h>
+#include <client_logger_builder.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+
+    logger *built_logger = builder->build();
+
+    delete builder;
+
+    return built_logger;
+}
+
+using mode = big_float::rounding_mode;
+
+constexpr mode all_modes[] = {mode::to_nearest, mode::toward_zero, mode::upward, mode::downward};
+
+/** Value in (low, low + 1) * 2^exponent for positive value, nearest_up tells which end is nearer
+ */
+struct rounding_case
+{
+    std::function<big_float(size_t, mode)> evaluate;
+    size_t precision;
+    std::string low;
+    std::int64_t exponent;
+    bool nearest_up;
+};
+
+big_float expected_rounding(rounding_case const &c, mode rounding)
+{
+    bool up = rounding == mode::upward || (rounding == mode::to_nearest && c.nearest_up);
+    return big_float(up ? big_int(c.low) + 1_bi : big_int(c.low), c.exponent, c.precision);
+}
+
+TEST(positive_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "big_float_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    // 4 bit mantissas: 17 and 19 lie halfway between neighbours 16, 18 and 18, 20
+    struct
+    {
+        int value;
+        int nearest;
+        int toward_zero;
+        int upward;
+        int downward;
+    } const cases[] = {
+        {17, 16, 16, 18, 16},
+        {19, 20, 18, 20, 18},
+        {-17, -16, -16, -16, -18},
+        {-19, -20, -18, -18, -20},
+        {23, 24, 22, 24, 22},
+        {25, 24, 24, 26, 24}
+    };
+
+    for (auto const &[value, nearest, toward_zero, upward, downward]: cases)
+    {
+        EXPECT_TRUE(big_float(big_int(value), 4, mode::to_nearest) == big_float(big_int(nearest), 64)) << value;
+        EXPECT_TRUE(big_float(big_int(value), 4, mode::toward_zero) == big_float(big_int(toward_zero), 64)) << value;
+        EXPECT_TRUE(big_float(big_int(value), 4, mode::upward) == big_float(big_int(upward), 64)) << value;
+        EXPECT_TRUE(big_float(big_int(value), 4, mode::downward) == big_float(big_int(downward), 64)) << value;
+    }
+
+    // halfway results of arithmetic, and bits beyond halfway break the tie
+    big_float fifteen(15_bi, 4), two(2_bi, 4), tiny(1_bi, -20, 64);
+
+    EXPECT_TRUE(fifteen + two == big_float(16_bi, 64));
+    EXPECT_TRUE(fifteen.rounded(4, mode::upward) + two == big_float(18_bi, 64));
+    EXPECT_TRUE(big_float(16_bi, 4) + big_float(1_bi, 64) == big_float(16_bi, 64));
+    EXPECT_TRUE(big_float(16_bi, 4) + big_float(big_int((1 << 20) + 1), -20, 64) == big_float(18_bi, 64));
+    EXPECT_TRUE(big_float(big_int(17 * 1024 + 1), -10, 4) == big_float(18_bi, 64));
+    EXPECT_TRUE(big_float(big_int(19 * 1024 - 1), -10, 4) == big_float(18_bi, 64));
+    EXPECT_TRUE(big_float(fraction(35_bi, 2_bi), 4, mode::to_nearest) == big_float(18_bi, 64));
+    EXPECT_TRUE(big_float(fraction(33_bi, 2_bi), 4, mode::to_nearest) == big_float(16_bi, 64));
+
+    // far smaller operand only moves directed rounding
+    big_float one(1_bi, 8, mode::upward);
+    EXPECT_TRUE(one + tiny > big_float(1_bi, 64));
+    EXPECT_TRUE(one.rounded(8, mode::to_nearest) + tiny == big_float(1_bi, 64));
+    EXPECT_TRUE(one.rounded(8, mode::downward) - tiny < big_float(1_bi, 64));
+    EXPECT_TRUE(one.rounded(8, mode::toward_zero) - tiny < big_float(1_bi, 64));
+
+    delete logger;
+}
+
+TEST(positive_tests, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "big_float_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    auto square_root = [](size_t precision, mode rounding) { return big_float(2_bi, precision, rounding).sqrt(); };
+    auto third = [](size_t precision, mode rounding) { return big_float(1_bi, precision, rounding) / big_float(3_bi, precision); };
+
+    // 53 bit results are those of IEEE double
+    rounding_case const cases[] = {
+        {square_root, 53, "6369051672525772", -52, true},
+        {square_root, 64, "13043817825332782212", -63, false},
+        {third, 53, "6004799503160661", -54, false},
+        {third, 64, "12297829382473034410", -65, true}
+    };
+
+    for (auto const &c: cases)
+    {
+        for (auto rounding: all_modes)
+        {
+            big_float value = c.evaluate(c.precision, rounding);
+
+            EXPECT_TRUE(value == expected_rounding(c, rounding)) << c.low << ' ' << value;
+            EXPECT_EQ(value.precision(), c.precision);
+            EXPECT_EQ(value.rounding(), rounding);
+        }
+    }
+
+    EXPECT_TRUE(big_float(2_bi, 53).sqrt().to_fraction() == fraction(big_int("6369051672525773"), 1_bi << 52));
+    EXPECT_TRUE(big_float(fraction(1_bi, 3_bi), 53).to_fraction() == fraction(big_int("6004799503160661"), 1_bi << 54));
+    EXPECT_TRUE(big_float(9_bi, 53).sqrt() == big_float(3_bi, 64));
+    EXPECT_EQ(big_float(2_bi, 53).sqrt().to_string(), "1.4142135623730951e0");
+
+    delete logger;
+}
+
+TEST(positive_tests, test3)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "big_float_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    auto e = [](size_t precision, mode rounding) { return big_float(1_bi, precision, rounding).exp(); };
+    auto ln2 = [](size_t precision, mode rounding) { return big_float(2_bi, precision, rounding).ln(); };
+    auto pi = [](size_t precision, mode rounding) { return big_float::pi(precision, rounding); };
+    auto sin1 = [](size_t precision, mode rounding) { return big_float(1_bi, precision, rounding).sin(); };
+    auto quarter_pi = [](size_t precision, mode rounding) { return big_float(1_bi, precision, rounding).arctg(); };
+
+    rounding_case const cases[] = {
+        {e, 53, "6121026514868073", -51, false},
+        {e, 64, "12535862302449814170", -62, true},
+        {ln2, 53, "6243314768165359", -53, false},
+        {ln2, 64, "12786308645202655659", -64, true},
+        {pi, 53, "7074237752028440", -51, false},
+        {pi, 64, "14488038916154245684", -62, true},
+        {sin1, 53, "7579296827247854", -53, false},
+        {sin1, 64, "15522399902203605024", -64, true},
+        {quarter_pi, 53, "7074237752028440", -53, false},
+        {quarter_pi, 64, "14488038916154245684", -64, true}
+    };
+
+    for (auto const &c: cases)
+    {
+        for (auto rounding: all_modes)
+        {
+            big_float value = c.evaluate(c.precision, rounding);
+            EXPECT_TRUE(value == expected_rounding(c, rounding)) << c.low << ' ' << value;
+        }
+    }
+
+    // exact values are returned as they are
+    EXPECT_TRUE(big_float(64).exp() == big_float(1_bi, 64) && big_float(1_bi, 64).ln() == big_float(64));
+    EXPECT_TRUE(big_float(64).sin() == big_float(64) && big_float(64).cos() == big_float(1_bi, 64));
+    EXPECT_TRUE(big_float(64).tg() == big_float(64) && big_float(64).arctg() == big_float(64));
+
+    // odd functions round symmetrically
+    big_float minus_one(big_int(-1), 64, mode::upward);
+    EXPECT_TRUE(minus_one.sin() == big_float(0_bi - big_int("15522399902203605024"), -64, 64));
+    EXPECT_TRUE(minus_one.rounded(64, mode::downward).arctg() == big_float(0_bi - big_int("14488038916154245685"), -64, 64));
+
+    delete logger;
+}
+
+TEST(positive_tests, test4)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "big_float_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    big_float one(1_bi, 64), zero(64);
+
+    EXPECT_THROW(one / zero, std::logic_error);
+    EXPECT_THROW(zero / zero, std::logic_error);
+    EXPECT_THROW(one /= big_float(128), std::logic_error);
+    EXPECT_TRUE(one == big_float(1_bi, 64));
+
+    EXPECT_THROW(big_float(big_int(-2), 64).sqrt(), std::invalid_argument);
+    EXPECT_THROW(zero.ln(), std::invalid_argument);
+    EXPECT_THROW(big_float(big_int(-1), 64).ln(), std::invalid_argument);
+    EXPECT_THROW(big_float(0), std::invalid_argument);
+    EXPECT_THROW(big_float(fraction(1_bi, 3_bi), fraction()), std::invalid_argument);
+    EXPECT_THROW(one.to_fraction(fraction(big_int(-1), 10_bi)), std::invalid_argument);
+
+    delete logger;
+}
+
+TEST(positive_tests, test5)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "big_float_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    big_float third(fraction(1_bi, 3_bi), 64), minus_third(fraction(big_int(-1), 3_bi), 64);
+    fraction epsilon(1_bi, 1000_bi);
+
+    // 2^-10 <= 1 / 1000, so value goes to nearest multiple of 2^-10
+    EXPECT_TRUE(third.to_fraction(epsilon) == fraction(341_bi, 1024_bi));
+    EXPECT_TRUE(minus_third.to_fraction(epsilon) == fraction(big_int(-341), 1024_bi));
+    EXPECT_TRUE(big_float(fraction(2047_bi, 2048_bi), 64).to_fraction(epsilon) == fraction(1_bi, 1_bi));
+
+    // values exact at epsilon come back unchanged
+    EXPECT_TRUE(big_float(fraction(3_bi, 4_bi), 64).to_fraction(epsilon) == fraction(3_bi, 4_bi));
+    EXPECT_TRUE(big_float(12345_bi, 64).to_fraction(epsilon) == fraction(12345_bi, 1_bi));
+    EXPECT_TRUE(third.to_fraction() == fraction(big_int("12297829382473034411"), 1_bi << 65));
+    EXPECT_TRUE(static_cast<fraction>(third) == third.to_fraction());
+
+    for (auto const &[numerator, denominator]: {std::pair{1, 3}, std::pair{-22, 7}, std::pair{355, 113}, std::pair{1, 100000}})
+    {
+        fraction value{big_int(numerator), big_int(denominator)}, close(1_bi, 1000000000_bi);
+        big_float rounded(value, close);
+        fraction difference = rounded.to_fraction() - value, shortened = big_float(value, 128).to_fraction(close) - value;
+
+        EXPECT_TRUE(difference <= close && difference >= fraction() - close) << numerator << '/' << denominator;
+        EXPECT_TRUE(shortened <= close && shortened >= fraction() - close) << numerator << '/' << denominator;
+    }
+
+    delete logger;
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,502 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+#include <fraction.h>
+#include <client_logger.h>
+#include <client_logger_builder.h>
+
+logger *create_logger(
+    std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
+    bool use_console_stream = true,
+    logger::severity console_stream_severity = logger::severity::debug)
+{
+    logger_builder *builder = new client_logger_builder();
+
+    if (use_console_stream)
+    {
+        builder->add_console_stream(console_stream_severity);
+    }
+
+    for (auto &output_file_stream_setup: output_file_streams_setup)
+    {
+        builder->add_file_stream(output_file_stream_setup.first, output_file_stream_setup.second);
+    }
+
+    logger *built_logger = builder->build();
+
+    delete builder;
+
+    return built_logger;
+}
+
+fraction from_decimal(std::string const &value)
+{
+    size_t point = value.find('.');
+    std::string digits = value.substr(0, point), scale = "1";
+
+    if (point != std::string::npos)
+    {
+        digits += value.substr(point + 1);
+        scale += std::string(value.size() - point - 1, '0');
+    }
+
+    return fraction(big_int(digits), big_int(scale));
+}
+
+big_int leading_digit(char digit, char rest, size_t length)
+{
+    std::string digits(length + 1, rest);
+    digits[0] = digit;
+    return big_int(digits);
+}
+
+bool is_near(fraction const &value, fraction const &expected, fraction const &epsilon)
+{
+    fraction difference = value - expected;
+    return difference <= epsilon && difference >= fraction() - epsilon;
+}
+
+TEST(positive_tests, test1)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    fraction max(big_int("9223372036854775807"), 1_bi), one(1_bi, 1_bi);
+
+    // INT64_MAX + 1 leaves int64 and comes back after subtraction
+    fraction promoted = max + one;
+    EXPECT_EQ(promoted.to_string(), "9223372036854775808/1");
+    EXPECT_EQ((promoted - one).to_string(), "9223372036854775807/1");
+    EXPECT_TRUE(promoted - one == max);
+
+    // INT64_MIN numerator is kept in big_int, one step up fits again
+    fraction min(big_int("-9223372036854775808"), 1_bi);
+    EXPECT_EQ(min.to_string(), "-9223372036854775808/1");
+    EXPECT_TRUE(min + one == fraction(big_int("-9223372036854775807"), 1_bi));
+    EXPECT_EQ((fraction() - max - one).to_string(), "-9223372036854775808/1");
+
+    // products overflow in denominator and cancel back by cross gcds
+    fraction small(1_bi, big_int("9223372036854775807"));
+    EXPECT_EQ((small * fraction(1_bi, 2_bi)).to_string(), "1/18446744073709551614");
+    EXPECT_TRUE(small * max == one);
+    EXPECT_EQ((max * max / max).to_string(), "9223372036854775807/1");
+    EXPECT_EQ((fraction(big_int("18446744073709551616"), big_int("36893488147419103232"))).to_string(), "1/2");
+    EXPECT_EQ(fraction(1_bi, big_int(-2)).to_string(), "-1/2");
+
+    delete logger;
+}
+
+TEST(positive_tests, test2)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    for (auto const &[numerator, denominator]: {std::pair{"3", "7"},
+                                                std::pair{"-9223372036854775807", "2"},
+                                                std::pair{"9223372036854775807", "9223372036854775806"},
+                                                std::pair{"-123456789012345678901234567890", "987654321"},
+                                                std::pair{"1", "340282366920938463463374607431768211457"}})
+    {
+        fraction x{big_int(numerator), big_int(denominator)};
+        fraction negated = fraction() - x;
+
+        EXPECT_TRUE(x + negated == fraction());
+        EXPECT_EQ((x + negated).to_string(), "0/1");
+        EXPECT_EQ((x - x).to_string(), "0/1");
+        EXPECT_TRUE(negated + x == fraction(0_bi, 5_bi));
+    }
+
+    EXPECT_THROW(fraction(1_bi, 3_bi) / fraction(), std::logic_error);
+    EXPECT_THROW(fraction(1_bi, 0_bi), std::logic_error);
+
+    delete logger;
+}
+
+TEST(positive_tests, test3)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    fraction small(1_bi, 3_bi), big(big_int("18446744073709551617"), big_int("55340232221128654848"));
+    fraction max(big_int("9223372036854775807"), 1_bi), above(big_int("9223372036854775808"), 1_bi);
+
+    EXPECT_FALSE(small == big);
+    EXPECT_TRUE(small < big && big > small);
+    EXPECT_TRUE(max < above && above > max && max != above);
+    EXPECT_TRUE((fraction() - above) < (fraction() - max));
+    EXPECT_TRUE((max <=> above) == std::partial_ordering::less);
+    EXPECT_TRUE((above - fraction(1_bi, 1_bi) <=> max) == std::partial_ordering::equivalent);
+    EXPECT_TRUE(above - fraction(1_bi, 1_bi) == max);
+
+    // values just around one with parts beyond int64
+    fraction below_one(big_int("18446744073709551615"), big_int("18446744073709551616"));
+    EXPECT_TRUE(below_one < fraction(1_bi, 1_bi) && below_one > fraction(big_int("9223372036854775806"), big_int("9223372036854775807")));
+    EXPECT_TRUE((fraction(2_bi, 4_bi) <=> fraction(big_int("9223372036854775808"), big_int("18446744073709551616"))) == std::partial_ordering::equivalent);
+
+    delete logger;
+}
+
+TEST(positive_tests, test4)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    fraction x;
+    std::stringstream input("-22/7 12 4/6 36893488147419103232/-6 1/0");
+
+    input >> x;
+    EXPECT_TRUE(x == fraction(big_int(-22), 7_bi));
+    EXPECT_EQ(x.to_string(), "-22/7");
+
+    input >> x;
+    EXPECT_EQ(x.to_string(), "12/1");
+
+    input >> x;
+    EXPECT_EQ(x.to_string(), "2/3");
+
+    input >> x;
+    EXPECT_EQ(x.to_string(), "-18446744073709551616/3");
+
+    EXPECT_TRUE((input >> x).fail());
+    EXPECT_EQ(x.to_string(), "-18446744073709551616/3");
+
+    delete logger;
+}
+
+TEST(positive_tests, test5)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    std::stringstream ss;
+    ss << fraction(big_int(-6), 4_bi) << ' ' << fraction() << ' ' << fraction(big_int("340282366920938463463374607431768211456"), 6_bi);
+    EXPECT_EQ(ss.str(), "-3/2 0/1 170141183460469231731687303715884105728/3");
+
+    EXPECT_EQ(fraction(big_int(-2), 3_bi).pow(3).to_string(), "-8/27");
+    EXPECT_EQ(fraction(5_bi, 7_bi).pow(0).to_string(), "1/1");
+    EXPECT_EQ(fraction(2_bi, 1_bi).pow(100).to_string(), "1267650600228229401496703205376/1");
+    EXPECT_EQ(fraction(big_int(-3), 2_bi).pow(41).to_string(), "-36472996377170786403/2199023255552");
+
+    delete logger;
+}
+
+TEST(positive_tests, test6)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    auto run = [](fraction::normalization_policy policy)
+    {
+        fraction::normalization = policy;
+        fraction sum, product(1_bi, 1_bi);
+
+        for (int k = 1; k <= 200; ++k)
+        {
+            sum += fraction(big_int(k % 7 == 0 ? -1 : 1), big_int(k));
+            product *= fraction(big_int(4 * k * k), big_int(4 * k * k - 1));
+        }
+
+        return std::pair{sum, product};
+    };
+
+    auto [eager_sum, eager_product] = run(fraction::normalization_policy::eager);
+
+    for (auto policy: {fraction::normalization_policy::lazy, fraction::normalization_policy::manual})
+    {
+        auto [sum, product] = run(policy);
+
+        EXPECT_TRUE(sum == eager_sum && product == eager_product);
+        EXPECT_EQ(sum.to_string(), eager_sum.to_string());
+        EXPECT_EQ(sum.normalize().to_string(), eager_sum.to_string());
+        EXPECT_EQ(product.normalize().to_string(), eager_product.to_string());
+        EXPECT_TRUE((sum <=> eager_sum) == std::partial_ordering::equivalent);
+    }
+
+    fraction::normalization = fraction::normalization_policy::eager;
+
+    delete logger;
+}
+
+TEST(positive_tests, test7)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    big_int factor("340282366920938463463374607431768211457");
+    fraction reduced(big_int("123456789012345678901234567890"), big_int("98765432109876543210987654321"));
+    std::string expected = reduced.to_string();
+
+    // under manual policy common factor of parts stays until normalize
+    fraction::normalization = fraction::normalization_policy::manual;
+
+    fraction unreduced(big_int("123456789012345678901234567890") * factor, big_int("98765432109876543210987654321") * factor);
+    fraction half(factor, factor * 2_bi);
+
+    EXPECT_TRUE(unreduced == reduced && reduced == unreduced);
+    EXPECT_TRUE(half == fraction(1_bi, 2_bi) && fraction(1_bi, 2_bi) == half);
+    EXPECT_FALSE(unreduced == reduced + fraction(1_bi, factor));
+    EXPECT_EQ(unreduced.to_string(), expected);
+    EXPECT_EQ(half.to_string(), "1/2");
+
+    std::stringstream ss;
+    ss << half << ' ' << unreduced;
+    EXPECT_EQ(ss.str(), "1/2 " + expected);
+
+    for (auto policy: {fraction::normalization_policy::eager,
+                       fraction::normalization_policy::lazy,
+                       fraction::normalization_policy::manual})
+    {
+        fraction::normalization = policy;
+
+        fraction value(big_int("123456789012345678901234567890") * factor, big_int("98765432109876543210987654321") * factor);
+        value += fraction(factor, factor);
+        value -= fraction(1_bi, 1_bi);
+
+        std::stringstream output;
+        output << value;
+        EXPECT_EQ(output.str(), expected);
+        EXPECT_TRUE(value == reduced);
+    }
+
+    fraction::normalization = fraction::normalization_policy::eager;
+
+    delete logger;
+}
+
+TEST(positive_tests, test8)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    using function = fraction (fraction::*)(fraction const &) const;
+
+    // references are truncated to 45 digits, far below epsilon
+    struct
+    {
+        function evaluate;
+        fraction argument;
+        std::string expected;
+    } const cases[] = {
+        {&fraction::sin, fraction(1_bi, 2_bi), "0.479425538604203000273287935215571388081803367"},
+        {&fraction::sin, fraction(big_int(-7), 3_bi), "-0.723085881738324616797887928616367326380143470"},
+        {&fraction::sin, fraction(100_bi, 1_bi), "-0.506365641109758793656557610459785432065032721"},
+        {&fraction::cos, fraction(1_bi, 2_bi), "0.877582561890372716116281582603829651991645197"},
+        {&fraction::cos, fraction(big_int(-7), 3_bi), "-0.690758139749876292727971694756348787010027486"},
+        {&fraction::cos, fraction(100_bi, 1_bi), "0.862318872287683934101938513950842535510084008"},
+        {&fraction::tg, fraction(1_bi, 2_bi), "0.546302489843790513255179465780285383297551720"},
+        {&fraction::tg, fraction(big_int(-7), 3_bi), "1.046800377915422333055465155667271413092072137"},
+        {&fraction::ctg, fraction(1_bi, 2_bi), "1.830487721712451919268019438968816623758107948"},
+        {&fraction::ctg, fraction(big_int(-7), 3_bi), "0.955291974570529211692750525165622813030522307"},
+        {&fraction::sec, fraction(1_bi, 2_bi), "1.139493927324549122313327768204949928423725246"},
+        {&fraction::sec, fraction(big_int(-7), 3_bi), "-1.447684714018860881800746598447587132127245440"},
+        {&fraction::cosec, fraction(1_bi, 2_bi), "2.085829642933488185772501675459290301962309586"},
+        {&fraction::cosec, fraction(big_int(-7), 3_bi), "-1.382961589010649503675641576628135413496591930"},
+        {&fraction::arcsin, fraction(1_bi, 3_bi), "0.339836909454121937096392513391764066388244690"},
+        {&fraction::arcsin, fraction(big_int(-4), 5_bi), "-0.927295218001612232428512462922428804057074108"},
+        {&fraction::arcsin, fraction(1_bi, 1_bi), "1.570796326794896619231321691639751442098584699"},
+        {&fraction::arccos, fraction(1_bi, 3_bi), "1.230959417340774682134929178247987375710340009"},
+        {&fraction::arccos, fraction(big_int(-4), 5_bi), "2.498091544796508851659834154562180246155658808"},
+        {&fraction::arctg, fraction(1_bi, 3_bi), "0.321750554396642193401404614358661319020755295"},
+        {&fraction::arctg, fraction(big_int(-5), 1_bi), "-1.373400766945015860861271926444961148650999595"},
+        {&fraction::arctg, fraction(1000_bi, 1_bi), "1.569796327128229752564797882004830898086963765"},
+        {&fraction::arcctg, fraction(1_bi, 3_bi), "1.249045772398254425829917077281090123077829404"},
+        {&fraction::arcctg, fraction(big_int(-5), 1_bi), "2.944197093739912480092593618084712590749584295"},
+        {&fraction::arcsec, fraction(2_bi, 1_bi), "1.047197551196597746154214461093167628065723133"},
+        {&fraction::arcsec, fraction(big_int(-3), 1_bi), "1.910633236249018556327714205031515508486829390"},
+        {&fraction::arccosec, fraction(2_bi, 1_bi), "0.523598775598298873077107230546583814032861566"},
+        {&fraction::arccosec, fraction(big_int(-3), 1_bi), "-0.339836909454121937096392513391764066388244690"},
+        {&fraction::log2, fraction(3_bi, 1_bi), "1.584962500721156181453738943947816508759814407"},
+        {&fraction::log2, fraction(1_bi, 1000_bi), "-9.965784284662087043610958288468170527594494179"},
+        {&fraction::ln, fraction(10_bi, 3_bi), "1.203972804325935992622746217761838502953610930"},
+        {&fraction::ln, fraction(1_bi, 7_bi), "-1.945910149055313305105352743443179729637084729"},
+        {&fraction::lg, fraction(7_bi, 1_bi), "0.845098040014256830712216258592636193483572396"},
+        {&fraction::lg, fraction(1_bi, 1000_bi), "-3"}
+    };
+
+    fraction epsilon(1_bi, big_int("1000000000000000000000000000000"));
+
+    for (auto const &[evaluate, argument, expected]: cases)
+    {
+        EXPECT_TRUE(is_near((argument.*evaluate)(epsilon), from_decimal(expected), epsilon)) << argument << ' ' << expected;
+    }
+
+    // default epsilon is 10^-6
+    EXPECT_TRUE(is_near(fraction(1_bi, 2_bi).sin(), from_decimal("0.479425538604203"), fraction(1_bi, 1000000_bi)));
+    EXPECT_TRUE(fraction().sin(epsilon) == fraction() && fraction().cos(epsilon) == fraction(1_bi, 1_bi));
+    EXPECT_TRUE(fraction(1_bi, 1_bi).ln(epsilon) == fraction() && fraction(1_bi, 1_bi).lg(epsilon) == fraction());
+
+    delete logger;
+}
+
+TEST(positive_tests, test9)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    fraction zero, one(1_bi, 1_bi), above(big_int(-5), 4_bi), epsilon(1_bi, 1000_bi);
+
+    EXPECT_THROW(zero.ctg(epsilon), std::logic_error);
+    EXPECT_THROW(zero.cosec(epsilon), std::logic_error);
+    EXPECT_THROW(above.arcsin(epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction(5_bi, 4_bi).arcsin(epsilon), std::invalid_argument);
+    EXPECT_THROW(above.arccos(epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction(1_bi, 2_bi).arcsec(epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction(big_int(-1), 2_bi).arccosec(epsilon), std::invalid_argument);
+    EXPECT_THROW(zero.ln(epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction(big_int(-1), 3_bi).ln(epsilon), std::invalid_argument);
+    EXPECT_THROW(zero.log2(epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction(big_int(-10), 1_bi).lg(epsilon), std::invalid_argument);
+    EXPECT_THROW(one.sin(zero), std::invalid_argument);
+    EXPECT_THROW(one.ln(fraction(big_int(-1), 1000_bi)), std::invalid_argument);
+
+    delete logger;
+}
+
+TEST(positive_tests, test10)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    // long binary splitting runs checked by identities at 10^-600
+    fraction epsilon(1_bi, leading_digit('1', '0', 600)), one(1_bi, 1_bi);
+    fraction x(big_int(-5), 7_bi), sin = x.sin(epsilon), cos = x.cos(epsilon);
+
+    EXPECT_TRUE(is_near(sin * sin + cos * cos, one, epsilon * fraction(5_bi, 1_bi)));
+    EXPECT_TRUE(is_near(fraction(6_bi, 1_bi).ln(epsilon), fraction(2_bi, 1_bi).ln(epsilon) + fraction(3_bi, 1_bi).ln(epsilon), epsilon * fraction(3_bi, 1_bi)));
+    EXPECT_TRUE(is_near(fraction(1_bi, 5_bi).arctg(epsilon) * fraction(4_bi, 1_bi) - fraction(1_bi, 239_bi).arctg(epsilon), one.arctg(epsilon), epsilon * fraction(6_bi, 1_bi)));
+    EXPECT_TRUE(is_near(fraction(1024_bi, 1_bi).log2(epsilon), fraction(10_bi, 1_bi), epsilon));
+
+    delete logger;
+}
+
+TEST(positive_tests, test11)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    fraction epsilon(1_bi, big_int("1000000000000000000000000000000"));
+    big_int digits = leading_digit('3', '1', 200);
+    auto power_of_ten = [](size_t n) { return leading_digit('1', '0', n); };
+    fraction long_small(digits, power_of_ten(201)), long_medium(digits, power_of_ten(200)), long_large(digits, power_of_ten(199));
+
+    // short argument, direct series with cancellation near pi
+    EXPECT_TRUE(is_near(fraction(355_bi, 113_bi).sin(epsilon), from_decimal("-0.000000266764189062419148406374528873468886822"), epsilon));
+
+    // short argument above 16, halving and doubling
+    EXPECT_TRUE(is_near(fraction(1000_bi, 3_bi).sin(epsilon), from_decimal("0.318846344358764098915239195487715943707448597"), epsilon));
+    EXPECT_TRUE(is_near(fraction(1000_bi, 3_bi).cos(epsilon), from_decimal("0.947806419417516089908340169863139649701768976"), epsilon));
+    EXPECT_TRUE(is_near(fraction(big_int(-123456789), 7_bi).sin(epsilon), from_decimal("-0.242073999491904182652043979194821580302254226"), epsilon));
+
+    // reduction modulo pi / 2 for short argument above 2^32 and for long one
+    EXPECT_TRUE(is_near(fraction(power_of_ten(15), 1_bi).sin(epsilon), from_decimal("0.858272793170235835523886390848406646600203408"), epsilon));
+    EXPECT_TRUE(is_near(fraction(power_of_ten(30), 3_bi).sin(epsilon), from_decimal("-0.850596027109012649504404871782019524024203598"), epsilon));
+    EXPECT_TRUE(is_near(fraction(power_of_ten(30), 3_bi).cos(epsilon), from_decimal("0.525819739707785996946735598774930097829936173"), epsilon));
+    EXPECT_TRUE(is_near(long_large.sin(epsilon), from_decimal("-0.300117113590455776768563951363609682480821712"), epsilon));
+    EXPECT_TRUE(is_near(long_large.tg(epsilon), from_decimal("-0.314620369162022377645431203508463783528565018"), epsilon));
+
+    // 200 digit arguments summed by chunks, below 1 / 2 without pi and above it after reduction
+    EXPECT_TRUE(is_near(long_small.sin(epsilon), from_decimal("0.306116596328920730011689394180310833816926894"), epsilon));
+    EXPECT_TRUE(is_near(long_small.cos(epsilon), from_decimal("0.951994028054796463197341457418303158592573429"), epsilon));
+    EXPECT_TRUE(is_near(long_medium.sin(epsilon), from_decimal("0.030476822506986460499558885536300708361257782"), epsilon));
+    EXPECT_TRUE(is_near(long_medium.cos(epsilon), from_decimal("-0.999535473752621570015262143053463525893139980"), epsilon));
+
+    // logarithm of short argument after power of two reduction, and chunk division for long ones
+    EXPECT_TRUE(is_near(fraction(power_of_ten(6), 1_bi).ln(epsilon), from_decimal("13.815510557964274104107948728106185245606608931"), epsilon));
+    EXPECT_TRUE(is_near(fraction(power_of_ten(300), 7_bi).ln(epsilon), from_decimal("688.829617749158391900292083661866082550693361859"), epsilon));
+    EXPECT_TRUE(is_near(long_small.ln(epsilon), from_decimal("-1.167605160155061142868664942169882751107997605"), epsilon));
+    EXPECT_TRUE(is_near(long_medium.ln(epsilon), from_decimal("1.134979932838984541149326512514481456493103882"), epsilon));
+    EXPECT_TRUE(is_near(long_large.lg(epsilon), from_decimal("1.492915521902894346549638241531391628619694430"), epsilon));
+
+    delete logger;
+}
+
+TEST(positive_tests, test12)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "fraction_logs.txt",
+                logger::severity::information
+            },
+        });
+
+    fraction epsilon(1_bi, 1000_bi);
+
+    EXPECT_TRUE(fraction(2_bi, 1_bi).root(2, epsilon) == fraction(1414_bi, 1000_bi));
+    EXPECT_TRUE(fraction(big_int(-27), 8_bi).root(3, epsilon) == fraction(big_int(-3), 2_bi));
+    EXPECT_TRUE(fraction(1_bi, 10000000_bi).root(2, epsilon) == fraction());
+
+    // domain is checked before radicand is scaled and truncated
+    EXPECT_THROW(fraction(big_int(-1), 1000000_bi).root(2, epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction(big_int(-1), 10000000_bi).root(2, epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction(big_int(-1), 10000000_bi).root(4, epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction(2_bi, 1_bi).root(0, epsilon), std::invalid_argument);
+    EXPECT_THROW(fraction(2_bi, 1_bi).root(2, fraction()), std::invalid_argument);
+
+    delete logger;
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}